@@ -12,11 +12,16 @@
 #define HARDWARE_AUDIO_H_
 
 #include <stdbool.h>
+#include <stddef.h>
+#if defined(HOST_BUILD)
+#include <board.h> /* host/board.h, which is ahead of bsp/ on the include path */
+#else
 #include "stm32f4xx.h"
 #include "system_stm32f4xx.h"
 
 #include "pins.h"
 #include "board.h"
+#endif
 
 /* I2S/DMA configuration for this board */
 #define I2S_SPI (SPI2)
@@ -29,33 +34,27 @@
 /* We want a 1MHz VCO for the I2S PLL, the other dividers are mode specific (see the LUT in audio.c) */
 #define I2S_M (LL_RCC_PLLI2SM_DIV_25)
 
-/* NOTE: Buffer size is linked to the wordlength, you must change this if using 16 versus 32*/
-
-//#define SAMPLE_RESOLUTION 16  
-#define SAMPLE_RESOLUTION 32  
+#define SAMPLE_BLOCK_SIZE 128								/* Default float samples per refill */
+#define SAMPLE_BLOCK_MIN 16									/* Runtime block size range, see audio_streaming_start() */
+#define SAMPLE_BLOCK_MAX 256
+#define AUDIO_RING_FRAMES (SAMPLE_BLOCK_MAX * 2) /* Frames shared out between the DMA ring segments */
+#define AUDIO_SEGMENTS_MAX (AUDIO_RING_FRAMES / SAMPLE_BLOCK_MIN)
+#define AUDIO_BUF_MAX (AUDIO_RING_FRAMES * 4) /* Static maximum for 24/32-bit frames, size the audio buffer with this */
 
-#define SAMPLE_BLOCK_SIZE 128								/* 128 float samples */
-#if SAMPLE_RESOLUTION == 32
-#define AUDIO_BUF_SGL SAMPLE_BLOCK_SIZE * 4 /* 2 * 32-bit I2S output samples * LR channels */
-#else 
-#define AUDIO_BUF_SGL SAMPLE_BLOCK_SIZE * 2 /* 2 * 16-bit I2S output samples * LR channels */
-#endif
-#define AUDIO_BUF_DBL AUDIO_BUF_SGL * 2			/* Double buffer */
+/* Converts a block of planar L/R float samples to interleaved I2S frames in the DMA buffer */
+typedef void (*audio_pack_t)(const float *left, const float *right, int16_t *out, size_t frames);
 
-/* Supported audio configurations */
+/* Supported audio configurations, 16-bit and 24/32-bit modes can be mixed at run time */
 typedef enum
 {
-#if SAMPLE_RESOLUTION == 16	
 	I2S_44_16,
 	I2S_48_16,
 	I2S_44_MCKOE_16,
 	I2S_48_MCKOE_16,
-#else
 	I2S_44_32,
 	I2S_48_32,
 	I2S_44_MCKOE_32,
 	I2S_48_MCKOE_32,
-#endif	
 } audio_mode_t;
 
 typedef struct
@@ -68,10 +67,44 @@ typedef struct
 	uint8_t MCKOE;
 	uint8_t bits;
 	float fsr;
+	uint16_t block;		/* Frames per refill, set by audio_streaming_start() */
+	uint8_t segments;	/* Segments in the DMA ring */
+	uint16_t segment; /* Halfwords per segment */
+	audio_pack_t pack; /* Float to I2S conversion for bits, see audio_convert.h */
 } audio_config_t;
 
 
+/* Render callback, run from PendSV at AUDIO_RENDER_PRIORITY, see audio_render.c */
+typedef void (*audio_render_t)(float *left, float *right, size_t frames, void *ctx);
+#define AUDIO_RENDER_PRIORITY (0x0F) /* Lowest, the DMA IRQ must be able to pre-empt it */
+
+/* Direct render callback, writes config->block I2S frames straight into the segment */
+typedef void (*audio_render_direct_t)(int16_t *out, size_t frames, void *ctx);
+
+/* Refill accounting, see audio_stats.c */
+typedef struct
+{
+	uint32_t requests;	/* Refills requested by the DMA */
+	uint32_t xruns;			/* Requests that arrived with every other segment still waiting for a refill */
+	uint32_t overlaps;	/* Refills that finished after the DMA had started sending that segment */
+	uint32_t last_xrun; /* profile_now() at the last xrun or overlap */
+} audio_stats_t;
 
 audio_config_t *audio_streaming_run(int16_t sample_buffer[], audio_mode_t audio_config_type);
+audio_config_t *audio_streaming_start(int16_t sample_buffer[], audio_mode_t audio_config_type, uint16_t block, uint8_t segments);
+int16_t *audio_segment_done(bool complete);
+uint32_t audio_stream_position(void);
+
+void audio_layout(audio_config_t *config, uint16_t block, uint8_t segments);
+void audio_render_start(audio_config_t *config, audio_render_t render, void *ctx, uint8_t priority);
+void audio_render_direct_start(audio_config_t *config, audio_render_direct_t render, void *ctx, uint8_t priority);
+void audio_render_request(int16_t *segment);
+
+void audio_stats_init(int16_t audio_buffer[], audio_config_t *config);
+void audio_refill_request(int16_t *segment);
+int16_t *audio_refill_next(void);
+void audio_refill_done(int16_t *segment);
+void audio_stats_get(audio_stats_t *stats);
+void audio_stats_reset(void);
 
 #endif /* HARDWARE_AUDIO_H_ */
@@ -0,0 +1,363 @@
+/**
+ * @file audio_convert.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Float to I2S frame conversion kernels
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Samples are scaled to Q15/Q31 (x 2^15 or 2^31) and rounded toward zero, which is
+ * what VCVT to fixed point does.  VCVT saturates to 32 bits by itself, SSAT takes the
+ * 16-bit results the rest of the way.  The reference code clamps the float first, as
+ * converting an out of range float to an integer is undefined in C.
+ *
+ * The fast kernels store whole words, a halfword-swapped 24/32-bit sample or a 16-bit
+ * L+R pair, so the output must be word aligned (the DMA ring segments always are).
+ */
+#include "audio.h"
+#include "audio_convert.h"
+
+/* ----------------------------------------------------------------------------
+ * Reference conversions
+ */
+static inline int32_t ref_q15(float x)
+{
+	if (x >= 1.0f)
+	{
+		return INT16_MAX;
+	}
+	if (x <= -1.0f)
+	{
+		return INT16_MIN;
+	}
+	return (int32_t)(x * 32768.0f);
+}
+
+static inline int32_t ref_q31(float x)
+{
+	if (x >= 1.0f)
+	{
+		return INT32_MAX;
+	}
+	if (x <= -1.0f)
+	{
+		return INT32_MIN;
+	}
+	return (int32_t)(x * 2147483648.0f);
+}
+
+/* ----------------------------------------------------------------------------
+ * Fast conversions, VCVT/SSAT where there is an FPU and the DSP extension
+ */
+#if defined(__ARM_FEATURE_DSP) && defined(__ARM_FP)
+
+static inline int32_t q15(float x)
+{
+	int32_t q;
+
+	__asm("vcvt.s32.f32 %1, %1, #15\n\tvmov %0, %1" : "=r"(q), "+t"(x));
+	return __SSAT(q, 16);
+}
+
+static inline int32_t q31(float x)
+{
+	int32_t q;
+
+	__asm("vcvt.s32.f32 %1, %1, #31\n\tvmov %0, %1" : "=r"(q), "+t"(x));
+	return q;
+}
+
+/* 24/32-bit sample to its halfword-swapped word, a single ROR */
+#define SWAP(q) __ROR((uint32_t)(q), 16)
+
+/* 16-bit L (low halfword, sent first) and R to one word, a single PKHBT */
+#define PAIR(l, r) __PKHBT((l), (r), 16)
+
+#else
+
+#define q15 ref_q15
+#define q31 ref_q31
+#define SWAP(q) (((uint32_t)(q) >> 16) | ((uint32_t)(q) << 16))
+#define PAIR(l, r) (((uint32_t)(l) & 0xFFFFU) | ((uint32_t)(r) << 16))
+
+#endif
+
+/**
+ * @brief Mono float to 16-bit I2S frames, the sample goes to L and R.
+ *
+ * @param in Float samples, -1.0 to 1.0
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of samples in
+ */
+void audio_convert_mono_16(const float *in, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+	size_t i = 0;
+
+	for (; i + 4 <= frames; i += 4)
+	{
+		int32_t a = q15(in[i]);
+		int32_t b = q15(in[i + 1]);
+		int32_t c = q15(in[i + 2]);
+		int32_t d = q15(in[i + 3]);
+
+		word[0] = PAIR(a, a);
+		word[1] = PAIR(b, b);
+		word[2] = PAIR(c, c);
+		word[3] = PAIR(d, d);
+		word += 4;
+	}
+
+	for (; i < frames; i++)
+	{
+		int32_t a = q15(in[i]);
+
+		*word++ = PAIR(a, a);
+	}
+}
+
+/**
+ * @brief Mono float to 24/32-bit I2S frames, the sample goes to L and R.
+ *
+ * @param in Float samples, -1.0 to 1.0
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of samples in
+ */
+void audio_convert_mono_32(const float *in, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+	size_t i = 0;
+
+	for (; i + 4 <= frames; i += 4)
+	{
+		uint32_t a = SWAP(q31(in[i]));
+		uint32_t b = SWAP(q31(in[i + 1]));
+		uint32_t c = SWAP(q31(in[i + 2]));
+		uint32_t d = SWAP(q31(in[i + 3]));
+
+		word[0] = a;
+		word[1] = a;
+		word[2] = b;
+		word[3] = b;
+		word[4] = c;
+		word[5] = c;
+		word[6] = d;
+		word[7] = d;
+		word += 8;
+	}
+
+	for (; i < frames; i++)
+	{
+		uint32_t a = SWAP(q31(in[i]));
+
+		*word++ = a;
+		*word++ = a;
+	}
+}
+
+/**
+ * @brief Planar stereo float to interleaved 16-bit I2S frames.
+ *
+ * @param left Left float samples, -1.0 to 1.0
+ * @param right Right float samples
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of frames
+ */
+void audio_convert_stereo_16(const float *left, const float *right, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+	size_t i = 0;
+
+	for (; i + 4 <= frames; i += 4)
+	{
+		word[0] = PAIR(q15(left[i]), q15(right[i]));
+		word[1] = PAIR(q15(left[i + 1]), q15(right[i + 1]));
+		word[2] = PAIR(q15(left[i + 2]), q15(right[i + 2]));
+		word[3] = PAIR(q15(left[i + 3]), q15(right[i + 3]));
+		word += 4;
+	}
+
+	for (; i < frames; i++)
+	{
+		*word++ = PAIR(q15(left[i]), q15(right[i]));
+	}
+}
+
+/**
+ * @brief Planar stereo float to interleaved 24/32-bit I2S frames.
+ *
+ * @param left Left float samples, -1.0 to 1.0
+ * @param right Right float samples
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of frames
+ */
+void audio_convert_stereo_32(const float *left, const float *right, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+	size_t i = 0;
+
+	for (; i + 4 <= frames; i += 4)
+	{
+		word[0] = SWAP(q31(left[i]));
+		word[1] = SWAP(q31(right[i]));
+		word[2] = SWAP(q31(left[i + 1]));
+		word[3] = SWAP(q31(right[i + 1]));
+		word[4] = SWAP(q31(left[i + 2]));
+		word[5] = SWAP(q31(right[i + 2]));
+		word[6] = SWAP(q31(left[i + 3]));
+		word[7] = SWAP(q31(right[i + 3]));
+		word += 8;
+	}
+
+	for (; i < frames; i++)
+	{
+		*word++ = SWAP(q31(left[i]));
+		*word++ = SWAP(q31(right[i]));
+	}
+}
+
+/* ----------------------------------------------------------------------------
+ * Fixed-point kernels, Q31 and Q15 blocks to frames, no conversion needed
+ */
+
+/**
+ * @brief Mono Q31 to 24/32-bit I2S frames, the sample goes to L and R.
+ *
+ * @param in Q31 samples
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of samples in
+ */
+void audio_convert_mono_q31(const int32_t *in, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		uint32_t a = SWAP(in[i]);
+
+		*word++ = a;
+		*word++ = a;
+	}
+}
+
+/**
+ * @brief Planar stereo Q31 to interleaved 24/32-bit I2S frames.
+ *
+ * @param left Left Q31 samples
+ * @param right Right Q31 samples
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of frames
+ */
+void audio_convert_stereo_q31(const int32_t *left, const int32_t *right, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		*word++ = SWAP(left[i]);
+		*word++ = SWAP(right[i]);
+	}
+}
+
+/**
+ * @brief Mono Q15 to 16-bit I2S frames, the sample goes to L and R.
+ *
+ * @param in Q15 samples
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of samples in
+ */
+void audio_convert_mono_q15(const int16_t *in, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		*word++ = PAIR(in[i], in[i]);
+	}
+}
+
+/**
+ * @brief Planar stereo Q15 to interleaved 16-bit I2S frames.
+ *
+ * @param left Left Q15 samples
+ * @param right Right Q15 samples
+ * @param out The buffer segment to fill (word aligned)
+ * @param frames Number of frames
+ */
+void audio_convert_stereo_q15(const int16_t *left, const int16_t *right, int16_t *out, size_t frames)
+{
+	uint32_t *word = (uint32_t *)out;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		*word++ = PAIR(left[i], right[i]);
+	}
+}
+
+/* ----------------------------------------------------------------------------
+ * Reference kernels, a halfword at a time
+ */
+
+/**
+ * @brief Reference for audio_convert_mono_16().
+ */
+void audio_convert_mono_16_ref(const float *in, int16_t *out, size_t frames)
+{
+	for (size_t i = 0; i < frames; i++)
+	{
+		int16_t sample = (int16_t)ref_q15(in[i]);
+
+		/* LEFT + RIGHT */
+		*out++ = sample;
+		*out++ = sample;
+	}
+}
+
+/**
+ * @brief Reference for audio_convert_mono_32().
+ */
+void audio_convert_mono_32_ref(const float *in, int16_t *out, size_t frames)
+{
+	for (size_t i = 0; i < frames; i++)
+	{
+		int32_t sample = ref_q31(in[i]);
+
+		/* LEFT + RIGHT */
+		*out++ = (int16_t)(sample >> 16); /* MSB in first word */
+		*out++ = (int16_t)(sample);				/* LSB in 2nd word */
+		*out++ = (int16_t)(sample >> 16);
+		*out++ = (int16_t)(sample);
+	}
+}
+
+/**
+ * @brief Reference for audio_convert_stereo_16().
+ */
+void audio_convert_stereo_16_ref(const float *left, const float *right, int16_t *out, size_t frames)
+{
+	for (size_t i = 0; i < frames; i++)
+	{
+		*out++ = (int16_t)ref_q15(left[i]);
+		*out++ = (int16_t)ref_q15(right[i]);
+	}
+}
+
+/**
+ * @brief Reference for audio_convert_stereo_32().
+ */
+void audio_convert_stereo_32_ref(const float *left, const float *right, int16_t *out, size_t frames)
+{
+	for (size_t i = 0; i < frames; i++)
+	{
+		int32_t l = ref_q31(left[i]);
+		int32_t r = ref_q31(right[i]);
+
+		*out++ = (int16_t)(l >> 16);
+		*out++ = (int16_t)(l);
+		*out++ = (int16_t)(r >> 16);
+		*out++ = (int16_t)(r);
+	}
+}
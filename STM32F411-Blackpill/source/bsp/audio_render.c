@@ -0,0 +1,139 @@
+/**
+ * @file audio_render.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Buffer layout and callback driven rendering from PendSV
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The template normally polls audio_refill_next() from the super-loop in main().  As
+ * an alternative a render callback can be registered with audio_render_start().  The
+ * DMA IRQ handler then calls audio_render_request() with the segment to refill, which
+ * pends PendSV.  PendSV runs at a low priority (AUDIO_RENDER_PRIORITY), calls the
+ * callback for a block of planar L/R float samples and packs them into each waiting
+ * segment.
+ *
+ * Render start jitter is then only the interrupt latency and the super-loop is free
+ * for MIDI and UI work.  The DMA IRQ can still pre-empt a render that runs late, so
+ * those xruns are still counted (see audio_stats.c).
+ *
+ * A fixed-point renderer can instead be registered with audio_render_direct_start().
+ * It is handed the segment itself and writes I2S frames straight into it (see
+ * audio_frame_16() and audio_frame_32()), saving the float block and the pack pass.
+ * It must write the frame size of config->bits.
+ */
+#include <stddef.h>
+#include "audio.h"
+#include "audio_convert.h"
+
+static audio_config_t *render_config;
+static audio_render_t render_callback;
+static audio_render_direct_t render_direct;
+static void *render_context;
+
+static float render_left[SAMPLE_BLOCK_MAX];
+static float render_right[SAMPLE_BLOCK_MAX];
+
+/**
+ * @brief Lays the ring out for the config's sample size and picks its packing.
+ * @details Shared by audio_streaming_start() on the target and the host.  block is
+ * clamped to SAMPLE_BLOCK_MIN..SAMPLE_BLOCK_MAX and segments to what fits in
+ * AUDIO_RING_FRAMES.  16-bit frames are two halfwords, 24/32-bit frames four.
+ *
+ * @param config The config from the LUT, receives the layout
+ * @param block Frames per refill
+ * @param segments Segments in the ring, at least 2
+ */
+void audio_layout(audio_config_t *config, uint16_t block, uint8_t segments)
+{
+	block = block < SAMPLE_BLOCK_MIN ? SAMPLE_BLOCK_MIN : block > SAMPLE_BLOCK_MAX ? SAMPLE_BLOCK_MAX : block;
+	segments = segments < 2 ? 2 : segments;
+	while (block * segments > AUDIO_RING_FRAMES)
+	{
+		segments--;
+	}
+
+	config->block = block;
+	config->segments = segments;
+	config->segment = block * (config->bits == 16 ? 2 : 4);
+	config->pack = config->bits == 16 ? audio_convert_stereo_16 : audio_convert_stereo_32;
+}
+
+/**
+ * @brief Registers a render callback, refills are then run from PendSV.
+ *
+ * @param config The config returned by audio_streaming_start()
+ * @param render Called with L and R blocks of config->block floats to fill
+ * @param ctx Passed to the callback
+ * @param priority NVIC priority for PendSV, must be lower (numerically higher) than the DMA IRQ
+ */
+void audio_render_start(audio_config_t *config, audio_render_t render, void *ctx, uint8_t priority)
+{
+	render_config = config;
+	render_context = ctx;
+	render_callback = render;
+	render_direct = NULL;
+
+	NVIC_SetPriority(PendSV_IRQn, priority);
+}
+
+/**
+ * @brief Registers a direct render callback, refills are then run from PendSV.
+ *
+ * @param config The config returned by audio_streaming_start()
+ * @param render Called with the segment to fill with config->block frames of config->bits
+ * @param ctx Passed to the callback
+ * @param priority NVIC priority for PendSV, must be lower (numerically higher) than the DMA IRQ
+ */
+void audio_render_direct_start(audio_config_t *config, audio_render_direct_t render, void *ctx, uint8_t priority)
+{
+	render_config = config;
+	render_context = ctx;
+	render_callback = NULL;
+	render_direct = render;
+
+	NVIC_SetPriority(PendSV_IRQn, priority);
+}
+
+/**
+ * @brief Asks for a buffer segment to be refilled, call from the DMA IRQ handler.
+ *
+ * @param segment The segment to refill (from audio_segment_done())
+ */
+void audio_render_request(int16_t *segment)
+{
+	audio_refill_request(segment);
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+/**
+ * @brief Runs the render callback for each segment waiting to be refilled.
+ */
+void PendSV_Handler(void)
+{
+	int16_t *segment;
+
+	if (render_callback == NULL && render_direct == NULL)
+	{
+		return;
+	}
+
+	while ((segment = audio_refill_next()) != NULL)
+	{
+		if (render_direct != NULL)
+		{
+			render_direct(segment, render_config->block, render_context);
+		}
+		else
+		{
+			render_callback(render_left, render_right, render_config->block, render_context);
+			render_config->pack(render_left, render_right, segment, render_config->block);
+		}
+
+		/* Did the DMA get to this segment before we finished? */
+		audio_refill_done(segment);
+	}
+}
@@ -25,7 +25,10 @@
 #include <stm32f4xx_ll_rcc.h>
 #include <stm32f4xx_ll_spi.h>
 #include <stm32f4xx_ll_bus.h>
+#include <stm32f4xx_ll_rng.h>
 
 #include "pins.h"
 
+uint32_t board_seed(void);
+
 #endif /* HARDWARE_BOARD_H_ */
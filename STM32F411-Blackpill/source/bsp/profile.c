@@ -0,0 +1,86 @@
+/**
+ * @file profile.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Render budget profiler using the DWT cycle counter
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <stddef.h>
+#include "audio.h"
+#include "profile.h"
+
+profile_section_t profile_sections[PROFILE_SECTIONS];
+
+/* Ticks available to refill one block */
+static uint32_t deadline;
+
+/**
+ * @brief Starts the cycle counter and names the sections.
+ *
+ * @param period The block period in seconds (block / fsr from the audio config), this sets the deadline
+ * @param names Section names, indexed by the ids passed to profile_begin()
+ * @param count Number of names (up to PROFILE_SECTIONS)
+ */
+void profile_init(float period, const char *names[], uint8_t count)
+{
+#if !defined(HOST_BUILD)
+	/* Trace on, then start the cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	deadline = (uint32_t)(PROFILE_CLOCK * period);
+
+	for (uint8_t i = 0; i < PROFILE_SECTIONS; i++)
+	{
+		profile_sections[i].name = i < count ? names[i] : NULL;
+	}
+	profile_reset();
+}
+
+/**
+ * @brief Clears the accumulated timings, names are kept.
+ */
+void profile_reset(void)
+{
+	for (uint8_t i = 0; i < PROFILE_SECTIONS; i++)
+	{
+		profile_section_t *s = &profile_sections[i];
+
+		s->min = UINT32_MAX;
+		s->max = 0;
+		s->total = 0;
+		s->count = 0;
+	}
+}
+
+/**
+ * @brief Summarises a section against the block deadline.
+ *
+ * @param id The section index
+ * @param stats Receives the summary
+ * @return true if the section has been run at least once
+ */
+bool profile_get(uint8_t id, profile_stats_t *stats)
+{
+	profile_section_t *s = &profile_sections[id];
+
+	if (s->count == 0)
+	{
+		return false;
+	}
+
+	stats->name = s->name;
+	stats->count = s->count;
+	stats->min = s->min;
+	stats->max = s->max;
+	stats->mean = (uint32_t)(s->total / s->count);
+	stats->usage_mean = 100.0f * stats->mean / deadline;
+	stats->usage_max = 100.0f * stats->max / deadline;
+
+	return true;
+}
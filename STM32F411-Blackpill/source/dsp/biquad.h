@@ -0,0 +1,80 @@
+/**
+ * @file biquad.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Cascades of up to 8 biquad filters, processed a block at a time
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Each section is a transposed direct form II biquad, which keeps two state values
+ * and behaves well in float.  The section types are those of the RBJ Audio EQ
+ * Cookbook: low pass, high pass, band pass (0 dB peak), notch, low and high shelf and
+ * peaking EQ.  Chain sections for steeper slopes (two low passes at Q 0.54 and 1.31
+ * are a 24 dB/oct Butterworth) or for a several band EQ.
+ *
+ * The coefficients are worked out against the sample rate (pConfig->fsr) by
+ * biquad_set() and kept with the parameters they came from.  Calling it again with
+ * the same parameters costs a compare, so it can be called every block from a patch
+ * without a sinf()/cosf() unless something moved.  Changing the sample rate with
+ * biquad_set_fsr() recomputes every section.
+ *
+ * A block is filtered in place a section at a time, mono or stereo, so a section's
+ * coefficients and state stay in registers across the block.  The coefficients jump
+ * to new values between blocks, so sweep by small steps (see ramp.h) or use the state
+ * variable filter for fast modulation.
+ */
+#ifndef DSP_BIQUAD_H_
+#define DSP_BIQUAD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BIQUAD_SECTIONS 8
+
+typedef enum
+{
+	BIQUAD_LOWPASS,
+	BIQUAD_HIGHPASS,
+	BIQUAD_BANDPASS,
+	BIQUAD_NOTCH,
+	BIQUAD_LOW_SHELF,
+	BIQUAD_HIGH_SHELF,
+	BIQUAD_PEAK
+} biquad_type_t;
+
+typedef struct
+{
+	/* The parameters the coefficients are for */
+	biquad_type_t type;
+	float frequency; /* Hz */
+	float q;
+	float gain; /* dB, shelves and peak */
+
+	/* Normalised so a0 is 1 */
+	float b0;
+	float b1;
+	float b2;
+	float a1;
+	float a2;
+} biquad_section_t;
+
+typedef struct
+{
+	uint8_t sections;
+	float fsr;
+	biquad_section_t section[BIQUAD_SECTIONS];
+	float state[2][BIQUAD_SECTIONS][2]; /* Channel, section, s1 and s2 */
+} biquad_t;
+
+void biquad_init(biquad_t *filter, int sections, float fsr);
+void biquad_set(biquad_t *filter, int section, biquad_type_t type, float frequency, float q, float gain);
+void biquad_set_fsr(biquad_t *filter, float fsr);
+void biquad_reset(biquad_t *filter);
+
+void biquad_process(biquad_t *filter, float *buffer, size_t frames);
+void biquad_process_stereo(biquad_t *filter, float *left, float *right, size_t frames);
+
+#endif /* DSP_BIQUAD_H_ */
@@ -0,0 +1,188 @@
+/**
+ * @file delay.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Power-of-two delay lines with fractional reads
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The per-sample reads and writes are inline in delay.h.  The block helpers here
+ * split a block at the end of the buffer, so each part is a straight copy (or
+ * conversion, for Q15) with no masking inside the loop.
+ */
+#include <string.h>
+#include "delay.h"
+
+/**
+ * @brief The largest power of two no bigger than size.
+ */
+static uint32_t power_of_two(uint32_t size)
+{
+	uint32_t p = 1;
+
+	while (p <= size / 2)
+	{
+		p *= 2;
+	}
+	return p;
+}
+
+/**
+ * @brief Sets up a float line and clears it.
+ *
+ * @param d The line
+ * @param buffer Its samples, declare with DELAY_RAM
+ * @param size Samples in buffer, a power of two (DELAY_SIZE()), else rounded down
+ */
+void delay_init(delay_t *d, float *buffer, uint32_t size)
+{
+	d->buffer = buffer;
+	d->mask = power_of_two(size) - 1;
+	d->write = 0;
+	delay_clear(d);
+}
+
+/**
+ * @brief Silences a float line.
+ *
+ * @param d The line
+ */
+void delay_clear(delay_t *d)
+{
+	memset(d->buffer, 0, (d->mask + 1) * sizeof(float));
+}
+
+/**
+ * @brief Writes a block, as frames calls of delay_write().
+ *
+ * @param d The line
+ * @param in Samples to write
+ * @param frames Number of samples, up to the line size
+ */
+void delay_write_block(delay_t *d, const float *in, size_t frames)
+{
+	uint32_t start = d->write & d->mask;
+	size_t first = d->mask + 1 - start;
+
+	if (first >= frames)
+	{
+		memcpy(&d->buffer[start], in, frames * sizeof(float));
+	}
+	else
+	{
+		memcpy(&d->buffer[start], in, first * sizeof(float));
+		memcpy(d->buffer, in + first, (frames - first) * sizeof(float));
+	}
+	d->write += (uint32_t)frames;
+}
+
+/**
+ * @brief Reads a block delayed by n, before the block is written.
+ * @details out[i] is what delay_tap(d, n) would give just before the i-th of frames
+ * writes, so n must be at least frames.
+ *
+ * @param d The line
+ * @param out Receives the samples
+ * @param n Delay in samples, frames to size
+ * @param frames Number of samples
+ */
+void delay_read_block(const delay_t *d, float *out, uint32_t n, size_t frames)
+{
+	uint32_t start = (d->write - n) & d->mask;
+	size_t first = d->mask + 1 - start;
+
+	if (first >= frames)
+	{
+		memcpy(out, &d->buffer[start], frames * sizeof(float));
+	}
+	else
+	{
+		memcpy(out, &d->buffer[start], first * sizeof(float));
+		memcpy(out + first, d->buffer, (frames - first) * sizeof(float));
+	}
+}
+
+/**
+ * @brief Sets up a Q15 line and clears it.
+ *
+ * @param d The line
+ * @param buffer Its samples, declare with DELAY_RAM
+ * @param size Samples in buffer, a power of two (DELAY_SIZE()), else rounded down
+ */
+void delay_q15_init(delay_q15_t *d, int16_t *buffer, uint32_t size)
+{
+	d->buffer = buffer;
+	d->mask = power_of_two(size) - 1;
+	d->write = 0;
+	delay_q15_clear(d);
+}
+
+/**
+ * @brief Silences a Q15 line.
+ *
+ * @param d The line
+ */
+void delay_q15_clear(delay_q15_t *d)
+{
+	memset(d->buffer, 0, (d->mask + 1) * sizeof(int16_t));
+}
+
+/**
+ * @brief Writes a block, as frames calls of delay_q15_write().
+ *
+ * @param d The line
+ * @param in Samples to write, saturated to -1.0 to 1.0
+ * @param frames Number of samples, up to the line size
+ */
+void delay_q15_write_block(delay_q15_t *d, const float *in, size_t frames)
+{
+	uint32_t start = d->write & d->mask;
+	size_t first = d->mask + 1 - start;
+
+	if (first > frames)
+	{
+		first = frames;
+	}
+
+	for (size_t i = 0; i < first; i++)
+	{
+		d->buffer[start + i] = delay_q15(in[i]);
+	}
+	for (size_t i = first; i < frames; i++)
+	{
+		d->buffer[i - first] = delay_q15(in[i]);
+	}
+	d->write += (uint32_t)frames;
+}
+
+/**
+ * @brief Reads a block delayed by n, before the block is written (see
+ * delay_read_block()).
+ *
+ * @param d The line
+ * @param out Receives the samples
+ * @param n Delay in samples, frames to size
+ * @param frames Number of samples
+ */
+void delay_q15_read_block(const delay_q15_t *d, float *out, uint32_t n, size_t frames)
+{
+	uint32_t start = (d->write - n) & d->mask;
+	size_t first = d->mask + 1 - start;
+
+	if (first > frames)
+	{
+		first = frames;
+	}
+
+	for (size_t i = 0; i < first; i++)
+	{
+		out[i] = d->buffer[start + i] * (1.0f / 32768.0f);
+	}
+	for (size_t i = first; i < frames; i++)
+	{
+		out[i] = d->buffer[i - first] * (1.0f / 32768.0f);
+	}
+}
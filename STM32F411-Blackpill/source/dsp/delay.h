@@ -0,0 +1,223 @@
+/**
+ * @file delay.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Power-of-two delay lines with fractional reads
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * A delay line is a ring buffer of a power-of-two number of samples, so the index
+ * wraps with a mask rather than a compare and branch.  The write index just counts
+ * up, a uint32_t wrapping at 2^32 which is a multiple of any size.  Lines hold float,
+ * or Q15 (delay_q15_t) for twice the length in the same RAM, read back as float.
+ *
+ * Read before writing: delay_tap(d, n) is the sample written n writes ago, so for
+ * n >= 1 reading then writing gives a delay of n samples.  Fractional reads, for
+ * t in samples:
+ *
+ *   delay_read_linear()    1 <= t <= size - 1, 2 taps, rolls off the top octave a
+ *                          little when t is between samples
+ *   delay_read_lagrange()  2 <= t <= size - 2, 4 taps, 3rd order Lagrange, flat to
+ *                          well past fsr / 4, for chorus and modulated reverb
+ *   delay_read_allpass()   1.5 <= t <= size - 1, 2 taps and a state, 1st order
+ *                          Thiran allpass, flat magnitude at every frequency but
+ *                          clicks if t jumps, for tuned delays (strings, combs)
+ *
+ * delay_write_block() and delay_read_block() move a whole block at a fixed delay of
+ * at least the block size, as at most two copies either side of the wrap.  Q15 lines
+ * can also be read and written in Q31 for fixed-point effects, with several lines
+ * packed in one ring.
+ *
+ * The buffers are the caller's, declared with DELAY_RAM to put them in the .delay
+ * section, which the linker scripts place after .bss without clearing it at start
+ * up (delay_init() clears a line).  Define DELAY_RAM before including this to put
+ * them elsewhere.  At 48 kHz the F411's 128K of RAM takes up to DELAY_SIZE(14)
+ * floats (0.34 s) or DELAY_SIZE(15) Q15 (0.68 s), the F767's 512K DELAY_SIZE(16)
+ * floats (1.37 s) or DELAY_SIZE(17) Q15 (2.73 s).
+ */
+#ifndef DSP_DELAY_H_
+#define DSP_DELAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DELAY_SIZE(bits) (1UL << (bits))
+
+#ifndef DELAY_RAM
+#if defined(HOST_BUILD)
+#define DELAY_RAM
+#else
+#define DELAY_RAM __attribute__((section(".delay"), aligned(4)))
+#endif
+#endif
+
+typedef struct
+{
+	float *buffer;
+	uint32_t mask; /* Size - 1 */
+	uint32_t write; /* Counts up, masked on use */
+} delay_t;
+
+typedef struct
+{
+	int16_t *buffer;
+	uint32_t mask;
+	uint32_t write;
+} delay_q15_t;
+
+/* ----------------------------------------------------------------------------
+ * Interpolators, between x0 (the shorter delay) and x1, f from 0 to 1
+ */
+static inline float delay_lerp(float x0, float x1, float f)
+{
+	return x0 + f * (x1 - x0);
+}
+
+/**
+ * @brief 3rd order Lagrange through xm1, x0, x1 and x2 at positions -1 to 2.
+ */
+static inline float delay_lagrange3(float xm1, float x0, float x1, float x2, float f)
+{
+	float d1 = f - 1.0f;
+	float d2 = f - 2.0f;
+	float dp = f + 1.0f;
+
+	return d1 * d2 * (f * (-1.0f / 6.0f) * xm1 + dp * 0.5f * x0) + dp * f * (d2 * -0.5f * x1 + d1 * (1.0f / 6.0f) * x2);
+}
+
+/**
+ * @brief 1st order allpass for a delay of 1 + d past x0, d from -0.5 to 0.5.
+ */
+static inline float delay_allpass1(float x0, float x1, float d, float *state)
+{
+	float eta = -d / (2.0f + d); /* (1 - D) / (1 + D) for D = 1 + d */
+	float y = x1 + eta * (x0 - *state);
+
+	*state = y;
+	return y;
+}
+
+/* ----------------------------------------------------------------------------
+ * Float lines
+ */
+static inline void delay_write(delay_t *d, float x)
+{
+	d->buffer[d->write++ & d->mask] = x;
+}
+
+/**
+ * @brief The sample written n writes ago, n from 1 to size.
+ */
+static inline float delay_tap(const delay_t *d, uint32_t n)
+{
+	return d->buffer[(d->write - n) & d->mask];
+}
+
+static inline float delay_read_linear(const delay_t *d, float t)
+{
+	uint32_t n = (uint32_t)t;
+
+	return delay_lerp(delay_tap(d, n), delay_tap(d, n + 1), t - n);
+}
+
+static inline float delay_read_lagrange(const delay_t *d, float t)
+{
+	uint32_t n = (uint32_t)t;
+
+	return delay_lagrange3(delay_tap(d, n - 1), delay_tap(d, n), delay_tap(d, n + 1), delay_tap(d, n + 2), t - n);
+}
+
+/**
+ * @brief Allpass interpolated read, state is the caller's, one per read position.
+ */
+static inline float delay_read_allpass(const delay_t *d, float t, float *state)
+{
+	uint32_t n = (uint32_t)(t - 0.5f);
+
+	return delay_allpass1(delay_tap(d, n), delay_tap(d, n + 1), t - n - 1.0f, state);
+}
+
+/* ----------------------------------------------------------------------------
+ * Q15 lines, the same reads, saturating on write
+ */
+/**
+ * @brief Rounds to nearest, truncating would pull a recirculating tail to zero early.
+ */
+static inline int16_t delay_q15(float x)
+{
+	float y = x * 32768.0f + (x < 0.0f ? -0.5f : 0.5f);
+
+	return (int16_t)(y > 32767.0f ? 32767.0f : y < -32768.0f ? -32768.0f : y);
+}
+
+static inline void delay_q15_write(delay_q15_t *d, float x)
+{
+	d->buffer[d->write++ & d->mask] = delay_q15(x);
+}
+
+static inline float delay_q15_tap(const delay_q15_t *d, uint32_t n)
+{
+	return d->buffer[(d->write - n) & d->mask] * (1.0f / 32768.0f);
+}
+
+static inline float delay_q15_read_linear(const delay_q15_t *d, float t)
+{
+	uint32_t n = (uint32_t)t;
+
+	return delay_lerp(delay_q15_tap(d, n), delay_q15_tap(d, n + 1), t - n);
+}
+
+static inline float delay_q15_read_lagrange(const delay_q15_t *d, float t)
+{
+	uint32_t n = (uint32_t)t;
+
+	return delay_lagrange3(delay_q15_tap(d, n - 1), delay_q15_tap(d, n), delay_q15_tap(d, n + 1), delay_q15_tap(d, n + 2),
+												 t - n);
+}
+
+static inline float delay_q15_read_allpass(const delay_q15_t *d, float t, float *state)
+{
+	uint32_t n = (uint32_t)(t - 0.5f);
+
+	return delay_allpass1(delay_q15_tap(d, n), delay_q15_tap(d, n + 1), t - n - 1.0f, state);
+}
+
+/* ----------------------------------------------------------------------------
+ * Q31 access to Q15 lines, for fixed-point effects.  Several short lines can share
+ * one ring, each at its own offset o (see plate.c): put its input at tap -o, read
+ * tap n - o for its n-th last input and delay_q15_advance() once a sample.
+ */
+static inline int32_t delay_q15_tap_q31(const delay_q15_t *d, uint32_t n)
+{
+	return d->buffer[(d->write - n) & d->mask] * 65536;
+}
+
+/**
+ * @brief Stores a Q31 sample at tap n, rounded and saturated to Q15.
+ */
+static inline void delay_q15_put_q31(delay_q15_t *d, uint32_t n, int32_t x)
+{
+	int32_t y = (x >> 16) + ((x >> 15) & 1);
+
+	d->buffer[(d->write - n) & d->mask] = (int16_t)(y > 32767 ? 32767 : y);
+}
+
+static inline void delay_q15_advance(delay_q15_t *d)
+{
+	d->write++;
+}
+
+void delay_init(delay_t *d, float *buffer, uint32_t size);
+void delay_clear(delay_t *d);
+void delay_write_block(delay_t *d, const float *in, size_t frames);
+void delay_read_block(const delay_t *d, float *out, uint32_t n, size_t frames);
+
+void delay_q15_init(delay_q15_t *d, int16_t *buffer, uint32_t size);
+void delay_q15_clear(delay_q15_t *d);
+void delay_q15_write_block(delay_q15_t *d, const float *in, size_t frames);
+void delay_q15_read_block(const delay_q15_t *d, float *out, uint32_t n, size_t frames);
+
+#endif /* DSP_DELAY_H_ */
@@ -0,0 +1,194 @@
+/**
+ * @file ladder.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Zero-delay-feedback 4-pole ladder low pass with an audio rate cutoff
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Each trapezoidal one-pole, with G = g / (1 + g), is
+ *
+ *   v = G (u - s),  y = v + s,  s = y + v
+ *
+ * so its output is G u + (1 - G) s.  Through all four, the output is
+ * G^4 u + S with S = (1 - G) (G^3 s1 + G^2 s2 + G s3 + s4), and with u = x - k y
+ * the loop solves to
+ *
+ *   y = (G^4 x + S) / (1 + k G^4)
+ *
+ * That y gives the input to the first stage, and the four stages are then run as
+ * normal.  For the per-sample cutoff, g = n / d from zdf_tan(), and scaling the top
+ * and bottom by (n + d)^4 leaves one divide for G and the solution together.
+ */
+#include <stdbool.h>
+#include "ladder.h"
+#include "zdf.h"
+
+static void design(ladder_t *ladder)
+{
+	float n, d;
+
+	zdf_tan(zdf_warp(ladder->cutoff, ladder->scale), &n, &d);
+
+	float G = n / (n + d);
+	float G2 = G * G;
+
+	ladder->G = G;
+	ladder->h = 1.0f / (1.0f + ladder->k * G2 * G2);
+}
+
+static inline void run(ladder_t *ladder, float *x, const float *cutoff, size_t frames, bool modulated)
+{
+	float G = ladder->G;
+	float h = ladder->h;
+	float k = ladder->k;
+	float gain = 1.0f + k;
+	float scale = ladder->scale;
+	float s1 = ladder->s[0];
+	float s2 = ladder->s[1];
+	float s3 = ladder->s[2];
+	float s4 = ladder->s[3];
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float in = gain * x[i];
+		float y;
+
+		if (modulated)
+		{
+			float n, d;
+
+			zdf_tan(zdf_warp(cutoff[i], scale), &n, &d);
+
+			float e = n + d;
+			float n2 = n * n;
+			float e2 = e * e;
+			float top = n2 * n2 * in + d * (n * (n * (n * s1 + e * s2) + e2 * s3) + e2 * e * s4);
+			float bottom = e2 * e2 + k * n2 * n2;
+			float r = 1.0f / (e * bottom);
+
+			y = top * e * r;
+			G = n * bottom * r;
+		}
+		else
+		{
+			float G2 = G * G;
+			float S = (1.0f - G) * (((G * s1 + s2) * G + s3) * G + s4);
+
+			y = (G2 * G2 * in + S) * h;
+		}
+
+		float u = in - k * y;
+		float v;
+
+		v = G * (u - s1);
+		u = v + s1;
+		s1 = u + v;
+		v = G * (u - s2);
+		u = v + s2;
+		s2 = u + v;
+		v = G * (u - s3);
+		u = v + s3;
+		s3 = u + v;
+		v = G * (u - s4);
+		u = v + s4;
+		s4 = u + v;
+		x[i] = u;
+	}
+
+	ladder->s[0] = s1;
+	ladder->s[1] = s2;
+	ladder->s[2] = s3;
+	ladder->s[3] = s4;
+}
+
+/**
+ * @brief Sets up a filter, with its state cleared.
+ *
+ * @param ladder The filter
+ * @param cutoff In Hz, held below ZDF_CUTOFF_MAX x fsr
+ * @param resonance 0 to 1, 1 on the edge of self-oscillation
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void ladder_init(ladder_t *ladder, float cutoff, float resonance, float fsr)
+{
+	ladder->cutoff = cutoff;
+	ladder->scale = ZDF_PI / fsr;
+	ladder->resonance = -1.0f; /* So the set below designs */
+	ladder_set_resonance(ladder, resonance);
+	ladder_reset(ladder);
+}
+
+/**
+ * @brief Sets the cutoff for ladder_process(), only recomputing on a change.
+ *
+ * @param ladder The filter
+ * @param cutoff In Hz, held below ZDF_CUTOFF_MAX x fsr
+ */
+void ladder_set_cutoff(ladder_t *ladder, float cutoff)
+{
+	if (cutoff != ladder->cutoff)
+	{
+		ladder->cutoff = cutoff;
+		design(ladder);
+	}
+}
+
+/**
+ * @brief Sets the resonance, only recomputing on a change.
+ *
+ * @param ladder The filter
+ * @param resonance 0 to 1, 1 on the edge of self-oscillation
+ */
+void ladder_set_resonance(ladder_t *ladder, float resonance)
+{
+	resonance = resonance < 0.0f ? 0.0f : resonance > 1.0f ? 1.0f : resonance;
+	if (resonance != ladder->resonance)
+	{
+		ladder->resonance = resonance;
+		ladder->k = 4.0f * resonance;
+		design(ladder);
+	}
+}
+
+/**
+ * @brief Clears the state.
+ *
+ * @param ladder The filter
+ */
+void ladder_reset(ladder_t *ladder)
+{
+	for (int n = 0; n < 4; n++)
+	{
+		ladder->s[n] = 0.0f;
+	}
+}
+
+/**
+ * @brief Filters a block in place at the set cutoff.
+ *
+ * @param ladder The filter
+ * @param buffer Samples to filter
+ * @param frames Number of samples
+ */
+void ladder_process(ladder_t *ladder, float *buffer, size_t frames)
+{
+	run(ladder, buffer, NULL, frames, false);
+}
+
+/**
+ * @brief Filters a block in place with a cutoff for every sample.
+ * @details The set cutoff is left alone, ladder_process() goes back to it.
+ *
+ * @param ladder The filter
+ * @param buffer Samples to filter
+ * @param cutoff In Hz, one per sample, held below ZDF_CUTOFF_MAX x fsr
+ * @param frames Number of samples
+ */
+void ladder_process_mod(ladder_t *ladder, float *buffer, const float *cutoff, size_t frames)
+{
+	run(ladder, buffer, cutoff, frames, true);
+}
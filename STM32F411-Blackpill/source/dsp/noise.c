@@ -0,0 +1,232 @@
+/**
+ * @file noise.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief White, pink and LFSR noise generators
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * xorshift32 is three shift-and-XORs, each a single EOR with a shifted operand on
+ * Cortex-M, but each depends on the last.  Running four generators side by side
+ * gives the core (and the host's vector unit) four independent chains per pass.
+ *
+ * The pink rows are white >> 5, so the sum of all 16 plus a fresh white sample
+ * can't overflow; it is doubled (saturating) for the output, about -18 dBFS RMS.
+ * The row to update is the number of trailing zeros of a counter, one CLZ and an
+ * RBIT, so each sample updates one row and the output is a running sum.
+ *
+ * The type and output format are constants at each call of run(), as in phasor.c.
+ */
+#include <stdbool.h>
+#include "noise.h"
+#include "phasor.h"
+
+#define Q31_TO_FLOAT (1.0f / 2147483648.0f)
+
+static inline uint32_t xorshift(uint32_t x)
+{
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+
+static inline int32_t sat_double(int32_t x)
+{
+	return x > 0x3FFFFFFF ? INT32_MAX : x < -0x40000000 ? INT32_MIN : x * 2;
+}
+
+static inline void store(void *out, size_t i, int32_t y, float gain, bool q31, bool mix)
+{
+	if (q31)
+	{
+		((int32_t *)out)[i] = y;
+	}
+	else if (mix)
+	{
+		((float *)out)[i] += gain * (float)y;
+	}
+	else
+	{
+		((float *)out)[i] = gain * (float)y;
+	}
+}
+
+static inline void white(noise_t *noise, void *out, size_t frames, float gain, bool q31, bool mix)
+{
+	uint32_t s[4] = {noise->state[0], noise->state[1], noise->state[2], noise->state[3]};
+	size_t i = 0;
+
+	for (; i + 4 <= frames; i += 4)
+	{
+		for (int k = 0; k < 4; k++)
+		{
+			s[k] = xorshift(s[k]);
+			store(out, i + k, (int32_t)s[k], gain, q31, mix);
+		}
+	}
+
+	for (; i < frames; i++)
+	{
+		s[0] = xorshift(s[0]);
+		store(out, i, (int32_t)s[0], gain, q31, mix);
+	}
+
+	for (int k = 0; k < 4; k++)
+	{
+		noise->state[k] = s[k];
+	}
+}
+
+static inline void pink(noise_t *noise, void *out, size_t frames, float gain, bool q31, bool mix)
+{
+	uint32_t s0 = noise->state[0];
+	uint32_t s1 = noise->state[1];
+	uint32_t counter = noise->counter;
+	int32_t sum = noise->sum;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		int row = __builtin_ctz(++counter | (1U << (NOISE_PINK_ROWS - 1)));
+		int32_t value = (int32_t)(s0 = xorshift(s0)) >> 5;
+
+		sum += value - noise->rows[row];
+		noise->rows[row] = value;
+
+		s1 = xorshift(s1);
+		store(out, i, sat_double(sum + ((int32_t)s1 >> 5)), gain, q31, mix);
+	}
+
+	noise->state[0] = s0;
+	noise->state[1] = s1;
+	noise->counter = counter;
+	noise->sum = sum;
+}
+
+static inline void lfsr(noise_t *noise, void *out, size_t frames, float gain, bool q31, bool mix, int tap)
+{
+	uint32_t l = noise->lfsr;
+	uint32_t phase = noise->phase;
+	uint32_t inc = noise->inc;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		uint32_t next = phase + inc;
+
+		/* Step on each wrap of the clock */
+		if (next < phase)
+		{
+			l = (l >> 1) | (((l ^ (l >> tap)) & 1U) << 14);
+		}
+		phase = next;
+		store(out, i, (l & 1U) ? INT32_MAX : -INT32_MAX, gain, q31, mix);
+	}
+
+	noise->lfsr = l;
+	noise->phase = phase;
+}
+
+static inline void run(noise_t *noise, void *out, size_t frames, float gain, bool q31, bool mix)
+{
+	switch (noise->type)
+	{
+	case NOISE_WHITE:
+		white(noise, out, frames, gain, q31, mix);
+		break;
+	case NOISE_PINK:
+		pink(noise, out, frames, gain, q31, mix);
+		break;
+	case NOISE_LFSR:
+		lfsr(noise, out, frames, gain, q31, mix, 1);
+		break;
+	case NOISE_LFSR_SHORT:
+		lfsr(noise, out, frames, gain, q31, mix, 6);
+		break;
+	}
+}
+
+/**
+ * @brief Sets up a generator, the LFSR clock starts at fsr / 4.
+ *
+ * @param noise The generator
+ * @param type NOISE_WHITE, NOISE_PINK, NOISE_LFSR or NOISE_LFSR_SHORT
+ * @param seed Any value, see board_seed()
+ */
+void noise_init(noise_t *noise, noise_type_t type, uint32_t seed)
+{
+	noise->type = type;
+
+	/* Spread the seed over the generators (a splitmix32 step each), none may be 0 */
+	for (int k = 0; k < 4; k++)
+	{
+		uint32_t z = seed + 0x9E3779B9U * (uint32_t)(k + 1);
+
+		z = (z ^ (z >> 16)) * 0x85EBCA6BU;
+		z = (z ^ (z >> 13)) * 0xC2B2AE35U;
+		z ^= z >> 16;
+		noise->state[k] = z != 0 ? z : 0x6D2B79F5U;
+	}
+
+	noise->counter = 0;
+	noise->sum = 0;
+	for (int row = 0; row < NOISE_PINK_ROWS; row++)
+	{
+		noise->rows[row] = 0;
+	}
+
+	noise->lfsr = 1; /* As the NES powers up */
+	noise->phase = 0;
+	noise->inc = 1U << 30;
+}
+
+/**
+ * @brief Sets the LFSR clock, white and pink noise ignore it.
+ *
+ * @param noise The generator
+ * @param frequency Steps per second, up to fsr
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void noise_set_rate(noise_t *noise, float frequency, float fsr)
+{
+	noise->inc = phasor_increment(frequency, fsr);
+}
+
+/**
+ * @brief Renders a block of samples.
+ *
+ * @param noise The generator
+ * @param out Receives the samples
+ * @param frames Number of samples
+ */
+void noise_render(noise_t *noise, float *out, size_t frames)
+{
+	run(noise, out, frames, Q31_TO_FLOAT, false, false);
+}
+
+/**
+ * @brief Adds a block of samples to out.
+ *
+ * @param noise The generator
+ * @param out Samples to add to
+ * @param frames Number of samples
+ * @param gain Applied before adding
+ */
+void noise_mix(noise_t *noise, float *out, size_t frames, float gain)
+{
+	run(noise, out, frames, gain * Q31_TO_FLOAT, false, true);
+}
+
+/**
+ * @brief Renders a block of Q31 samples.
+ *
+ * @param noise The generator
+ * @param out Receives the samples
+ * @param frames Number of samples
+ */
+void noise_render_q31(noise_t *noise, int32_t *out, size_t frames)
+{
+	run(noise, out, frames, 1.0f, true, false);
+}
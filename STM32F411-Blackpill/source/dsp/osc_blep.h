@@ -0,0 +1,79 @@
+/**
+ * @file osc_blep.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Band-limited saw, pulse and triangle oscillators (PolyBLEP/PolyBLAMP)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Each voice keeps its own phase (0 to 1) and increment (frequency / fsr), so any
+ * number can run side by side.  A block is rendered at a time with one loop per
+ * shape, so there is no shape switch inside the sample loop.
+ *
+ * The naive waveform is corrected with a two-sample polynomial residual over each
+ * discontinuity: PolyBLEP for the steps of the saw and pulse, PolyBLAMP for the
+ * corners of the triangle.  Aliasing is then well down on the naive waveforms,
+ * without oversampling.  The correction assumes inc < 0.5, i.e. below Nyquist.
+ *
+ * The frequency can glide to a new one (osc_blep_set_glide()), the increment
+ * stepping every sample rather than every block so there is no zipper.  Once it has
+ * arrived the loop is the same as with no glide.
+ *
+ * The pulse is not DC corrected, its mean is 2 * width - 1.
+ */
+#ifndef DSP_OSC_BLEP_H_
+#define DSP_OSC_BLEP_H_
+
+#include <stddef.h>
+#include "ramp.h"
+
+typedef enum
+{
+	OSC_SAW,
+	OSC_PULSE,
+	OSC_TRIANGLE
+} osc_shape_t;
+
+typedef struct
+{
+	osc_shape_t shape;
+	float phase; /* 0 to 1 */
+	ramp_t inc;	 /* Cycles per sample, frequency / fsr, glides (see ramp.h) */
+	float width; /* Pulse width, 0 to 1 */
+} osc_blep_t;
+
+/**
+ * @brief The PolyBLEP residual for a falling step of 2 at phase 0 (see osc_blep.c).
+ *
+ * @param t Phase, 0 to 1
+ * @param dt Increment, cycles per sample
+ * @param rdt 1 / dt
+ * @return float Subtract from the naive saw
+ */
+static inline float osc_polyblep(float t, float dt, float rdt)
+{
+	if (t < dt)
+	{
+		t *= rdt;
+		return t + t - t * t - 1.0f;
+	}
+	if (t > 1.0f - dt)
+	{
+		t = (t - 1.0f) * rdt;
+		return t * t + t + t + 1.0f;
+	}
+	return 0.0f;
+}
+
+void osc_blep_init(osc_blep_t *osc, osc_shape_t shape, float frequency, float fsr);
+void osc_blep_set_frequency(osc_blep_t *osc, float frequency, float fsr);
+void osc_blep_set_glide(osc_blep_t *osc, ramp_type_t type, float seconds, float fsr);
+void osc_blep_set_width(osc_blep_t *osc, float width);
+
+void osc_blep_render(osc_blep_t *osc, float *out, size_t frames);
+void osc_blep_mix(osc_blep_t *osc, float *out, size_t frames, float gain);
+
+#endif /* DSP_OSC_BLEP_H_ */
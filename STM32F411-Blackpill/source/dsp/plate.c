@@ -0,0 +1,360 @@
+/**
+ * @file plate.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Fixed-point Dattorro plate reverb
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The allpasses are w = x - g d into the line, y = d + g w out, with d the line's
+ * output, and saturating adds (QADD and QSUB on the M4).  Multiplies are Q31 x Q31,
+ * a long multiply and a shift.  Each line is a range of the ring: line k at offset o
+ * is put at tap -o and its n-th last input is tap n - o, so all 12 share the one
+ * write index, advanced once a sample.
+ *
+ * The decay gain is applied twice in each half, four times round the figure of
+ * eight, so for a decay time T and a tank of L samples in all it is
+ * 10^(-3 L / (4 T fsr)).  The swept allpasses move over 16 samples at 29761 Hz with
+ * a 1 Hz triangle, the two halves a quarter cycle apart, read with linear
+ * interpolation.
+ */
+#include <math.h>
+#include "plate.h"
+
+#if defined(__ARM_FEATURE_DSP)
+
+#include "cmsis_compiler.h"
+
+#define QADD(a, b) __QADD((a), (b))
+#define QSUB(a, b) __QSUB((a), (b))
+
+#else
+
+#define QADD(a, b) qadd((a), (b))
+#define QSUB(a, b) qadd((a), -(b))
+
+static inline int32_t qadd(int32_t a, int32_t b)
+{
+	int64_t y = (int64_t)a + b;
+
+	return y > INT32_MAX ? INT32_MAX : y < INT32_MIN ? INT32_MIN : (int32_t)y;
+}
+
+#endif
+
+#define Q31(x) ((int32_t)((x) * 2147483648.0f))
+#define Q31_BELOW_ONE 0.99999994f /* The largest float under 1, 1.0 is past Q31 */
+#define DATTORRO_FSR 29761.0f
+
+/* Lines, in the order they are packed */
+enum
+{
+	IN_1,
+	IN_2,
+	IN_3,
+	IN_4,
+	LEFT_SWEPT,
+	LEFT_DELAY_1,
+	LEFT_ALLPASS,
+	LEFT_DELAY_2,
+	RIGHT_SWEPT,
+	RIGHT_DELAY_1,
+	RIGHT_ALLPASS,
+	RIGHT_DELAY_2
+};
+
+static const uint16_t lengths[PLATE_LINES] = {142, 107, 379, 277, 672, 4453, 1800, 3720, 908, 4217, 2656, 3163};
+
+/* Output taps, left then right, the first 3 of each added and the rest subtracted */
+static const struct
+{
+	uint8_t line;
+	uint16_t n;
+} taps[PLATE_TAPS] = {
+		{RIGHT_DELAY_1, 266}, {RIGHT_DELAY_1, 2974}, {RIGHT_DELAY_2, 1996}, {RIGHT_ALLPASS, 1913},
+		{LEFT_DELAY_1, 1990}, {LEFT_ALLPASS, 187},	 {LEFT_DELAY_2, 1066},	{LEFT_DELAY_1, 353},
+		{LEFT_DELAY_1, 3627}, {LEFT_DELAY_2, 2673},	 {LEFT_ALLPASS, 1228},	{RIGHT_DELAY_1, 2111},
+		{RIGHT_ALLPASS, 335}, {RIGHT_DELAY_2, 121},
+};
+
+static const int32_t input_diffusion[4] = {Q31(0.75f), Q31(0.75f), Q31(0.625f), Q31(0.625f)};
+#define DECAY_DIFFUSION_1 Q31(-0.70f)
+#define DECAY_DIFFUSION_2 Q31(0.50f)
+
+static inline int32_t mul(int32_t a, int32_t b)
+{
+	return (int32_t)(((int64_t)a * b) >> 31);
+}
+
+static inline int32_t tap(const delay_q15_t *ring, uint32_t offset, uint32_t n)
+{
+	return delay_q15_tap_q31(ring, n - offset);
+}
+
+static inline int32_t allpass(delay_q15_t *ring, uint32_t offset, uint32_t length, int32_t g, int32_t x)
+{
+	int32_t d = tap(ring, offset, length);
+	int32_t w = QSUB(x, mul(g, d));
+
+	delay_q15_put_q31(ring, -offset, w);
+	return QADD(d, mul(g, w));
+}
+
+/**
+ * @brief The allpass at the head of each half, its length swept by t (Q16 samples).
+ */
+static inline int32_t swept(delay_q15_t *ring, uint32_t offset, uint32_t t, int32_t x)
+{
+	uint32_t n = t >> 16;
+	int32_t a = tap(ring, offset, n);
+	int32_t b = tap(ring, offset, n + 1);
+	int32_t d = a + 2 * mul((b >> 1) - (a >> 1), (int32_t)((t & 0xFFFFU) << 15));
+	int32_t w = QSUB(x, mul(DECAY_DIFFUSION_1, d));
+
+	delay_q15_put_q31(ring, -offset, w);
+	return QADD(d, mul(DECAY_DIFFUSION_1, w));
+}
+
+static inline int32_t delay(delay_q15_t *ring, uint32_t offset, uint32_t length, int32_t x)
+{
+	int32_t d = tap(ring, offset, length);
+
+	delay_q15_put_q31(ring, -offset, x);
+	return d;
+}
+
+static inline uint32_t triangle(uint32_t phase)
+{
+	return (phase ^ (uint32_t)((int32_t)phase >> 31)) >> 15; /* 0 to 65535 */
+}
+
+/**
+ * @brief One half of the tank, from its input to the input of the other half.
+ */
+static inline int32_t half(delay_q15_t *ring, const uint32_t *offset, const uint32_t *length, int first, uint32_t t,
+													 int32_t gain, int32_t damp, int32_t undamp, int32_t *lowpass, int32_t x)
+{
+	x = swept(ring, offset[first], t, x);
+	x = delay(ring, offset[first + 1], length[first + 1], x);
+	*lowpass = mul(*lowpass, damp) + mul(x, undamp);
+	x = mul(*lowpass, gain);
+	x = allpass(ring, offset[first + 2], length[first + 2], DECAY_DIFFUSION_2, x);
+	return mul(delay(ring, offset[first + 3], length[first + 3], x), gain);
+}
+
+/**
+ * @brief A gain or pole from 0 to 1 as Q31, held just under 1.
+ */
+static int32_t q31_unit(float x)
+{
+	return Q31(x < 0.0f ? 0.0f : x < Q31_BELOW_ONE ? x : Q31_BELOW_ONE);
+}
+
+static void design(plate_t *plate)
+{
+	float tank = 0.0f;
+
+	for (int n = LEFT_SWEPT; n < PLATE_LINES; n++)
+	{
+		tank += plate->length[n];
+	}
+	plate->gain = q31_unit(powf(10.0f, -3.0f * tank / (4.0f * plate->decay * plate->fsr)));
+}
+
+/**
+ * @brief Sets up a plate and clears it, 2 s decay, 6 kHz damping, wet 0.3.
+ *
+ * @param plate The reverb
+ * @param ram The ring, declared with DELAY_RAM, PLATE_RAM bytes
+ * @param bytes Size of ram, if it can't hold every line at least a sample the plate
+ * is left silent and plate_process() leaves the block dry
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void plate_init(plate_t *plate, void *ram, size_t bytes, float fsr)
+{
+	uint32_t total = 0;
+	uint32_t offset = 0;
+	float scale = fsr / DATTORRO_FSR;
+	float room;
+
+	delay_q15_init(&plate->ring, ram, (uint32_t)(bytes / sizeof(int16_t)));
+
+	/* Dattorro's lengths at fsr, or smaller if the ring can't hold them */
+	plate->excursion = (uint32_t)(16.0f * scale + 0.5f);
+	for (int n = 0; n < PLATE_LINES; n++)
+	{
+		total += lengths[n];
+	}
+	room = (float)plate->ring.mask - 2 * PLATE_LINES - 2 * plate->excursion;
+	scale = scale * total < room ? scale : room / total;
+	if (scale * lengths[IN_2] < 1.0f) /* The shortest */
+	{
+		scale = 0.0f;
+		plate->excursion = 0;
+	}
+
+	for (int n = 0; n < PLATE_LINES; n++)
+	{
+		plate->length[n] = (uint32_t)(lengths[n] * scale);
+		offset += plate->length[n] + 2 + (n == LEFT_SWEPT || n == RIGHT_SWEPT ? plate->excursion : 0);
+		plate->offset[n] = offset;
+	}
+	for (int n = 0; n < PLATE_TAPS; n++)
+	{
+		plate->tap[n] = (uint32_t)(taps[n].n * scale) - plate->offset[taps[n].line];
+	}
+
+	plate->phase = 0;
+	plate->rate = (uint32_t)(4294967296.0f / fsr);
+	plate->lowpass[0] = plate->lowpass[1] = 0;
+	plate->feedback[0] = plate->feedback[1] = 0;
+	plate->fsr = fsr;
+	plate->decay = 2.0f;
+	design(plate);
+	plate->damping = -1.0f; /* So the set below designs */
+	plate_set_damping(plate, 6000.0f);
+	plate_set_wet(plate, 0.3f);
+}
+
+/**
+ * @brief Sets the decay time, only recomputing on a change.
+ *
+ * @param plate The reverb
+ * @param decay Seconds to fall 60 dB at low frequencies, 0.1 to 30
+ */
+void plate_set_decay(plate_t *plate, float decay)
+{
+	decay = decay < 0.1f ? 0.1f : decay > 30.0f ? 30.0f : decay;
+	if (decay != plate->decay)
+	{
+		plate->decay = decay;
+		design(plate);
+	}
+}
+
+/**
+ * @brief Sets the damping, only recomputing on a change.
+ *
+ * @param plate The reverb
+ * @param damping Cutoff in Hz of the low pass in each half, lower for a darker tail
+ */
+void plate_set_damping(plate_t *plate, float damping)
+{
+	if (damping != plate->damping)
+	{
+		plate->damping = damping;
+		plate->damp = q31_unit(expf(-6.28318531f * damping / plate->fsr)); /* Held under 1 at 0 Hz, undamped */
+	}
+}
+
+/**
+ * @brief Sets the level of the reverb added to the block.
+ *
+ * @param plate The reverb
+ * @param wet 0 to 1
+ */
+void plate_set_wet(plate_t *plate, float wet)
+{
+	plate->wet = wet;
+}
+
+/**
+ * @brief Silences the tail.
+ *
+ * @param plate The reverb
+ */
+void plate_clear(plate_t *plate)
+{
+	delay_q15_clear(&plate->ring);
+	plate->lowpass[0] = plate->lowpass[1] = 0;
+	plate->feedback[0] = plate->feedback[1] = 0;
+}
+
+/**
+ * @brief Adds the reverb of a stereo block to it, in place.
+ *
+ * @param plate The reverb
+ * @param left Left samples
+ * @param right Right samples
+ * @param frames Number of samples
+ */
+void plate_process(plate_t *plate, float *left, float *right, size_t frames)
+{
+	delay_q15_t ring = plate->ring;
+	uint32_t offset[PLATE_LINES];
+	uint32_t length[PLATE_LINES];
+	uint32_t t[PLATE_TAPS];
+	uint32_t excursion = plate->excursion;
+	uint32_t phase = plate->phase;
+	uint32_t rate = plate->rate;
+	int32_t gain = plate->gain;
+	int32_t damp = plate->damp;
+	int32_t undamp = INT32_MAX - damp;
+	int32_t lowpass[2] = {plate->lowpass[0], plate->lowpass[1]};
+	int32_t feedback[2] = {plate->feedback[0], plate->feedback[1]};
+	float wet = plate->wet * 0.6f * 4.0f / 8388608.0f; /* Dattorro's 0.6, the input's -12 dB, taps >> 8 */
+
+	if (plate->length[IN_2] == 0)
+	{
+		return; /* The ring was too small, see plate_init() */
+	}
+
+	for (int n = 0; n < PLATE_LINES; n++)
+	{
+		offset[n] = plate->offset[n];
+		length[n] = plate->length[n];
+	}
+	for (int n = 0; n < PLATE_TAPS; n++)
+	{
+		t[n] = plate->tap[n];
+	}
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float in = (left[i] + right[i]) * 0.125f;
+		int32_t x = Q31(in > 0.999f ? 0.999f : in < -0.999f ? -0.999f : in);
+		int32_t l = 0;
+		int32_t r = 0;
+
+		/* The taps before this sample's writes */
+		for (int n = 0; n < 3; n++)
+		{
+			l += delay_q15_tap_q31(&ring, t[n]) >> 8;
+			r += delay_q15_tap_q31(&ring, t[n + 7]) >> 8;
+		}
+		for (int n = 3; n < 7; n++)
+		{
+			l -= delay_q15_tap_q31(&ring, t[n]) >> 8;
+			r -= delay_q15_tap_q31(&ring, t[n + 7]) >> 8;
+		}
+		left[i] += wet * l;
+		right[i] += wet * r;
+
+		for (int n = IN_1; n <= IN_4; n++)
+		{
+			x = allpass(&ring, offset[n], length[n], input_diffusion[n], x);
+		}
+
+		uint32_t t_left = (length[LEFT_SWEPT] << 16) + triangle(phase) * excursion;
+		uint32_t t_right = (length[RIGHT_SWEPT] << 16) + triangle(phase + 0x40000000U) * excursion;
+		int32_t to_right = half(&ring, offset, length, LEFT_SWEPT, t_left, gain, damp, undamp, &lowpass[0],
+														QADD(x, feedback[1]));
+		int32_t to_left = half(&ring, offset, length, RIGHT_SWEPT, t_right, gain, damp, undamp, &lowpass[1],
+													 QADD(x, feedback[0]));
+
+		feedback[0] = to_right;
+		feedback[1] = to_left;
+		delay_q15_advance(&ring);
+		phase += rate;
+	}
+
+	plate->ring.write = ring.write;
+	plate->phase = phase;
+	plate->lowpass[0] = lowpass[0];
+	plate->lowpass[1] = lowpass[1];
+	plate->feedback[0] = feedback[0];
+	plate->feedback[1] = feedback[1];
+}
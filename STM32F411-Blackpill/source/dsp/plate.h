@@ -0,0 +1,70 @@
+/**
+ * @file plate.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Fixed-point Dattorro plate reverb
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Dattorro's plate (J. Audio Eng. Soc. 45(9), 1997): four allpass diffusers on the
+ * input, then a tank of two halves in a figure of eight, each a swept allpass, a
+ * delay, a damping low pass, the decay gain, an allpass and a second delay, feeding
+ * the other half.  The stereo outputs are 7 taps each across the tank.
+ *
+ * Everything in the loop is Q31 integer, so it doesn't compete with the voices for
+ * the FPU, only the block in and out are float.  The 12 lines are packed in one Q15
+ * delay ring (delay.h) of DELAY_SIZE(PLATE_BITS), PLATE_RAM bytes, which the build
+ * sets and reports (see CMakeLists.txt).  The lengths are Dattorro's, at 29761 Hz,
+ * scaled to fsr and, if they don't fit, down to the ring; DELAY_SIZE(15) (64K) holds
+ * 0.9 of the full size plate at 48 kHz, DELAY_SIZE(16) all of it.
+ *
+ * With the input at -12 dB into the tank, the plate has headroom for full scale
+ * blocks, the lines saturate rather than wrap past that.  Writes to the ring round to
+ * nearest, which keeps the tail smooth down to the Q15 floor, where it can idle at
+ * a bit or so (-90 dB) until plate_clear().
+ */
+#ifndef DSP_PLATE_H_
+#define DSP_PLATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "delay.h"
+
+#ifndef PLATE_BITS
+#define PLATE_BITS 15
+#endif
+#define PLATE_RAM (DELAY_SIZE(PLATE_BITS) * sizeof(int16_t))
+#define PLATE_LINES 12
+#define PLATE_TAPS 14
+
+typedef struct
+{
+	delay_q15_t ring;
+	uint32_t offset[PLATE_LINES]; /* Of each line in the ring */
+	uint32_t length[PLATE_LINES]; /* Samples */
+	uint32_t tap[PLATE_TAPS]; /* Output taps, as ring taps */
+	uint32_t excursion; /* Sweep of the tank allpasses, samples */
+	uint32_t phase; /* LFO */
+	uint32_t rate; /* LFO increment per sample */
+	int32_t gain; /* Q31 decay */
+	int32_t damp; /* Q31 damping coefficient, the pole */
+	int32_t lowpass[2]; /* Damping states, Q31 */
+	int32_t feedback[2]; /* Output of each half, into the other */
+	float fsr;
+	float decay; /* Seconds to -60 dB */
+	float damping; /* Hz */
+	float wet;
+} plate_t;
+
+void plate_init(plate_t *plate, void *ram, size_t bytes, float fsr);
+void plate_set_decay(plate_t *plate, float decay);
+void plate_set_damping(plate_t *plate, float damping);
+void plate_set_wet(plate_t *plate, float wet);
+void plate_clear(plate_t *plate);
+
+void plate_process(plate_t *plate, float *left, float *right, size_t frames);
+
+#endif /* DSP_PLATE_H_ */
@@ -0,0 +1,165 @@
+/**
+ * @file ramp.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Sample-accurate parameter ramps, linear and one-pole
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The one-pole is value += (1 - decay) (target - value), rearranged as
+ * value = value * decay + target (1 - decay) so both types share ramp_step().
+ * The scale and offset are worked out once per target, not per sample.
+ */
+#include <math.h>
+#include "ramp.h"
+
+#define ONE_POLE_SETTLE 9.21034037f /* ln(10000), time constants to within 1 / 10000 */
+
+/**
+ * @brief Sets up a ramp, settled at value.
+ *
+ * @param r The ramp
+ * @param type RAMP_LINEAR or RAMP_ONE_POLE
+ * @param value Starting value
+ * @param seconds Ramp time, the time constant for RAMP_ONE_POLE, 0 to jump
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void ramp_init(ramp_t *r, ramp_type_t type, float value, float seconds, float fsr)
+{
+	r->type = type;
+	ramp_set_time(r, seconds, fsr);
+	ramp_jump(r, value);
+}
+
+/**
+ * @brief Changes the ramp time, from the next ramp_set_target().
+ *
+ * @param r The ramp
+ * @param seconds Ramp time, the time constant for RAMP_ONE_POLE, 0 to jump
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void ramp_set_time(ramp_t *r, float seconds, float fsr)
+{
+	float samples = seconds * fsr;
+
+	if (samples < 1.0f)
+	{
+		r->length = 0;
+		r->decay = 0.0f;
+	}
+	else if (r->type == RAMP_LINEAR)
+	{
+		r->length = (uint32_t)(samples + 0.5f);
+		r->decay = 1.0f;
+	}
+	else
+	{
+		r->length = (uint32_t)ceilf(samples * ONE_POLE_SETTLE);
+		r->decay = expf(-1.0f / samples);
+	}
+}
+
+/**
+ * @brief Starts ramping from the current value to target.
+ *
+ * @param r The ramp
+ * @param target Value to move to
+ */
+void ramp_set_target(ramp_t *r, float target)
+{
+	if (r->length == 0 || target == r->value)
+	{
+		ramp_jump(r, target);
+		return;
+	}
+
+	r->target = target;
+	r->remaining = r->length;
+	if (r->type == RAMP_LINEAR)
+	{
+		r->scale = 1.0f;
+		r->offset = (target - r->value) / r->length;
+	}
+	else
+	{
+		r->scale = r->decay;
+		r->offset = target * (1.0f - r->decay);
+	}
+}
+
+/**
+ * @brief Moves straight to value, settled.
+ *
+ * @param r The ramp
+ * @param value The new value
+ */
+void ramp_jump(ramp_t *r, float value)
+{
+	r->value = value;
+	r->target = value;
+	r->scale = 1.0f;
+	r->offset = 0.0f;
+	r->remaining = 0;
+}
+
+/**
+ * @brief Writes a block of values, one per sample.
+ *
+ * @param r The ramp
+ * @param out Receives the values
+ * @param frames Number of samples
+ */
+void ramp_render(ramp_t *r, float *out, size_t frames)
+{
+	size_t n = ramp_span(r, frames);
+	float value = r->value;
+	const ramp_t ramp = *r; /* A local, out can't alias it */
+
+	for (size_t i = 0; i < n; i++)
+	{
+		value = ramp_step(&ramp, value);
+		out[i] = value;
+	}
+	ramp_advance(r, n, value);
+
+	value = r->value;
+	for (size_t i = n; i < frames; i++)
+	{
+		out[i] = value;
+	}
+}
+
+/**
+ * @brief Multiplies a block by the ramp, for a gain that doesn't zipper.
+ * @details Does nothing once settled at 1.
+ *
+ * @param r The ramp
+ * @param buffer Samples to scale
+ * @param frames Number of samples
+ */
+void ramp_apply(ramp_t *r, float *buffer, size_t frames)
+{
+	size_t n = ramp_span(r, frames);
+	float value = r->value;
+	const ramp_t ramp = *r;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		value = ramp_step(&ramp, value);
+		buffer[i] *= value;
+	}
+	ramp_advance(r, n, value);
+
+	value = r->value;
+	if (value == 1.0f)
+	{
+		return;
+	}
+	for (size_t i = n; i < frames; i++)
+	{
+		buffer[i] *= value;
+	}
+}
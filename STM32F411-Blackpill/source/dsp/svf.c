@@ -0,0 +1,226 @@
+/**
+ * @file svf.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Zero-delay-feedback state variable filter with an audio rate cutoff
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * With g = tan(pi fc / fsr) and k = 1 / Q, per sample
+ *
+ *   v3 = x - ic2
+ *   v1 = a1 ic1 + a2 v3            band
+ *   v2 = ic2 + a2 ic1 + a3 v3      low
+ *   ic1 = 2 v1 - ic1
+ *   ic2 = 2 v2 - ic2
+ *
+ * where a1 = 1 / (1 + g (g + k)), a2 = g a1 and a3 = g a2.  The output is
+ * m0 x + m1 v1 + m2 v2, the mix picking the response.
+ *
+ * g comes from zdf_tan() as n / d, so a1 = d^2 / (d^2 + n^2 + k n d) and so on, the
+ * one divide covering both the tangent and the feedback solution.
+ */
+#include <stdbool.h>
+#include "svf.h"
+#include "zdf.h"
+
+/**
+ * @brief The feedback solution for a cutoff, g = n / d.
+ */
+static inline void solve(float n, float d, float k, float *a1, float *a2, float *a3)
+{
+	float r = 1.0f / (d * d + n * n + k * n * d);
+
+	*a1 = d * d * r;
+	*a2 = n * d * r;
+	*a3 = n * n * r;
+}
+
+static void design(svf_t *svf)
+{
+	float n, d;
+
+	zdf_tan(zdf_warp(svf->cutoff, svf->scale), &n, &d);
+	solve(n, d, svf->k, &svf->a1, &svf->a2, &svf->a3);
+}
+
+static void mix(svf_t *svf)
+{
+	float k = svf->k;
+
+	switch (svf->mode)
+	{
+	case SVF_LOWPASS:
+		svf->m0 = 0.0f;
+		svf->m1 = 0.0f;
+		svf->m2 = 1.0f;
+		break;
+	case SVF_BANDPASS:
+		svf->m0 = 0.0f;
+		svf->m1 = k;
+		svf->m2 = 0.0f;
+		break;
+	case SVF_HIGHPASS:
+		svf->m0 = 1.0f;
+		svf->m1 = -k;
+		svf->m2 = -1.0f;
+		break;
+	case SVF_NOTCH:
+		svf->m0 = 1.0f;
+		svf->m1 = -k;
+		svf->m2 = 0.0f;
+		break;
+	case SVF_PEAK:
+		svf->m0 = -1.0f;
+		svf->m1 = k;
+		svf->m2 = 2.0f;
+		break;
+	case SVF_ALLPASS:
+		svf->m0 = 1.0f;
+		svf->m1 = -2.0f * k;
+		svf->m2 = 0.0f;
+		break;
+	}
+}
+
+static inline void run(svf_t *svf, float *x, const float *cutoff, size_t frames, bool modulated)
+{
+	float a1 = svf->a1;
+	float a2 = svf->a2;
+	float a3 = svf->a3;
+	float m0 = svf->m0;
+	float m1 = svf->m1;
+	float m2 = svf->m2;
+	float k = svf->k;
+	float scale = svf->scale;
+	float ic1 = svf->ic1;
+	float ic2 = svf->ic2;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		if (modulated)
+		{
+			float n, d;
+
+			zdf_tan(zdf_warp(cutoff[i], scale), &n, &d);
+			solve(n, d, k, &a1, &a2, &a3);
+		}
+
+		float v0 = x[i];
+		float v3 = v0 - ic2;
+		float v1 = a1 * ic1 + a2 * v3;
+		float v2 = ic2 + a2 * ic1 + a3 * v3;
+
+		ic1 = 2.0f * v1 - ic1;
+		ic2 = 2.0f * v2 - ic2;
+		x[i] = m0 * v0 + m1 * v1 + m2 * v2;
+	}
+
+	svf->ic1 = ic1;
+	svf->ic2 = ic2;
+}
+
+/**
+ * @brief Sets up a filter, with its state cleared.
+ *
+ * @param svf The filter
+ * @param mode The response
+ * @param cutoff In Hz, cutoff or centre, held below ZDF_CUTOFF_MAX x fsr
+ * @param q Resonance, 0.5 upwards, 0.707 for Butterworth
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void svf_init(svf_t *svf, svf_mode_t mode, float cutoff, float q, float fsr)
+{
+	svf->mode = mode;
+	svf->cutoff = cutoff;
+	svf->q = q;
+	svf->k = 1.0f / q;
+	svf->scale = ZDF_PI / fsr;
+	design(svf);
+	mix(svf);
+	svf_reset(svf);
+}
+
+/**
+ * @brief Changes the response, the state carries on so it can be switched live.
+ *
+ * @param svf The filter
+ * @param mode The response
+ */
+void svf_set_mode(svf_t *svf, svf_mode_t mode)
+{
+	svf->mode = mode;
+	mix(svf);
+}
+
+/**
+ * @brief Sets the cutoff for svf_process(), only recomputing on a change.
+ *
+ * @param svf The filter
+ * @param cutoff In Hz, held below ZDF_CUTOFF_MAX x fsr
+ */
+void svf_set_cutoff(svf_t *svf, float cutoff)
+{
+	if (cutoff != svf->cutoff)
+	{
+		svf->cutoff = cutoff;
+		design(svf);
+	}
+}
+
+/**
+ * @brief Sets the resonance, only recomputing on a change.
+ *
+ * @param svf The filter
+ * @param q 0.5 upwards, 0.707 for Butterworth
+ */
+void svf_set_q(svf_t *svf, float q)
+{
+	if (q != svf->q)
+	{
+		svf->q = q;
+		svf->k = 1.0f / q;
+		design(svf);
+		mix(svf);
+	}
+}
+
+/**
+ * @brief Clears the state.
+ *
+ * @param svf The filter
+ */
+void svf_reset(svf_t *svf)
+{
+	svf->ic1 = 0.0f;
+	svf->ic2 = 0.0f;
+}
+
+/**
+ * @brief Filters a block in place at the set cutoff.
+ *
+ * @param svf The filter
+ * @param buffer Samples to filter
+ * @param frames Number of samples
+ */
+void svf_process(svf_t *svf, float *buffer, size_t frames)
+{
+	run(svf, buffer, NULL, frames, false);
+}
+
+/**
+ * @brief Filters a block in place with a cutoff for every sample.
+ * @details The set cutoff is left alone, svf_process() goes back to it.
+ *
+ * @param svf The filter
+ * @param buffer Samples to filter
+ * @param cutoff In Hz, one per sample, held below ZDF_CUTOFF_MAX x fsr
+ * @param frames Number of samples
+ */
+void svf_process_mod(svf_t *svf, float *buffer, const float *cutoff, size_t frames)
+{
+	run(svf, buffer, cutoff, frames, true);
+}
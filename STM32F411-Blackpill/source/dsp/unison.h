@@ -0,0 +1,57 @@
+/**
+ * @file unison.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Supersaw, a stack of detuned band-limited saws spread across the stereo field
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * UNISON_MAX saws at most, 7 is the classic supersaw.  They are detuned evenly either
+ * side of the frequency, up to UNISON_DETUNE_CENTS, and panned alternately left and
+ * right by the spread, counting in from both ends so the image is balanced for odd
+ * and even counts alike.  Each saw is PolyBLEP corrected (see osc_blep.h).
+ *
+ * The detune, pan gains and level (1 / sqrt(voices), the saws being uncorrelated)
+ * are worked out once when a parameter changes, not per block or sample.  The block
+ * is then rendered by one loop, every saw for each sample, with no function call per
+ * saw, see unison.c.
+ *
+ * The saws start at spread out phases, so the stack doesn't open with a click.  The
+ * RMS is that of one saw but the saws line up now and then, peaks reach about 1.6,
+ * so mix it in at 0.6 or less where the output converter saturates.
+ */
+#ifndef DSP_UNISON_H_
+#define DSP_UNISON_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define UNISON_MAX 9
+#define UNISON_DETUNE_CENTS 100.0f /* Outer saws at a detune of 1 */
+
+typedef struct
+{
+	uint8_t voices;
+	float frequency;
+	float fsr;
+	float detune; /* 0 to 1 */
+	float spread; /* 0 (mono) to 1 (outer saws hard left and right) */
+	float phase[UNISON_MAX]; /* 0 to 1 */
+	float inc[UNISON_MAX];
+	float rinc[UNISON_MAX]; /* 1 / inc, for the PolyBLEP */
+	float left[UNISON_MAX]; /* Pan gains, with the level */
+	float right[UNISON_MAX];
+} unison_t;
+
+void unison_init(unison_t *osc, int voices, float frequency, float fsr);
+void unison_set_frequency(unison_t *osc, float frequency);
+void unison_set_detune(unison_t *osc, float detune);
+void unison_set_spread(unison_t *osc, float spread);
+
+void unison_render(unison_t *osc, float *left, float *right, size_t frames);
+void unison_mix(unison_t *osc, float *left, float *right, size_t frames, float gain);
+
+#endif /* DSP_UNISON_H_ */
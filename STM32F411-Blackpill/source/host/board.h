@@ -0,0 +1,106 @@
+/**
+ * @file board.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host stand-in for the board support configuration (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * This is found ahead of bsp/board.h by the host build and provides just enough of
+ * the CMSIS/LL surface for app/main.c to compile unmodified.  The DMA controller is
+ * reduced to its interrupt status/clear registers which are driven by the simulated
+ * I2S/DMA stream in audio_host.c.
+ */
+#ifndef HOST_BOARD_H_
+#define HOST_BOARD_H_
+
+#include <stdint.h>
+#include <time.h>
+
+/* Simulated DMA controller, only the interrupt status & flag clear registers */
+typedef struct
+{
+	volatile uint32_t LISR;
+	volatile uint32_t HISR;
+	volatile uint32_t LIFCR;
+	volatile uint32_t HIFCR;
+} DMA_TypeDef;
+
+extern DMA_TypeDef host_dma1;
+#define DMA1 (&host_dma1)
+
+/* DMA1 stream 4 flags (RM0383 9.5.2) */
+#define DMA_HISR_TEIF4 (1UL << 3)
+#define DMA_HISR_HTIF4 (1UL << 4)
+#define DMA_HISR_TCIF4 (1UL << 5)
+#define DMA_HIFCR_CTEIF4 DMA_HISR_TEIF4
+#define DMA_HIFCR_CHTIF4 DMA_HISR_HTIF4
+#define DMA_HIFCR_CTCIF4 DMA_HISR_TCIF4
+
+static inline uint32_t LL_DMA_IsActiveFlag_TC4(DMA_TypeDef *DMAx) { return (DMAx->HISR & DMA_HISR_TCIF4) == DMA_HISR_TCIF4; }
+static inline uint32_t LL_DMA_IsActiveFlag_HT4(DMA_TypeDef *DMAx) { return (DMAx->HISR & DMA_HISR_HTIF4) == DMA_HISR_HTIF4; }
+static inline uint32_t LL_DMA_IsActiveFlag_TE4(DMA_TypeDef *DMAx) { return (DMAx->HISR & DMA_HISR_TEIF4) == DMA_HISR_TEIF4; }
+static inline void LL_DMA_ClearFlag_TC4(DMA_TypeDef *DMAx) { DMAx->HIFCR = DMA_HIFCR_CTCIF4; }
+static inline void LL_DMA_ClearFlag_HT4(DMA_TypeDef *DMAx) { DMAx->HIFCR = DMA_HIFCR_CHTIF4; }
+static inline void LL_DMA_ClearFlag_TE4(DMA_TypeDef *DMAx) { DMAx->HIFCR = DMA_HIFCR_CTEIF4; }
+
+/* Simulated SCB and NVIC, just enough to pend PendSV */
+typedef struct
+{
+	volatile uint32_t ICSR;
+} SCB_Type;
+
+extern SCB_Type host_scb;
+#define SCB (&host_scb)
+#define SCB_ICSR_PENDSVSET_Msk (1UL << 28)
+
+typedef enum
+{
+	PendSV_IRQn = -2,
+} IRQn_Type;
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+	(void)IRQn;
+	(void)priority;
+}
+
+void PendSV_Handler(void);
+
+/* Which handler and flags the simulated stream raises for this board */
+#define HOST_DMA_IRQHandler DMA1_Stream4_IRQHandler
+#define HOST_DMA_FLAG_HT DMA_HISR_HTIF4
+#define HOST_DMA_FLAG_TC DMA_HISR_TCIF4
+
+void HOST_DMA_IRQHandler(void);
+
+/* No logic analyser on the host, use the profiler (profile.h) */
+#define PROBE1_SET()
+#define PROBE2_SET()
+#define PROBE3_SET()
+#define PROBE4_SET()
+#define PROBE5_SET()
+#define PROBE6_SET()
+#define PROBE7_SET()
+#define PROBE8_SET()
+
+#define PROBE1_CLEAR()
+#define PROBE2_CLEAR()
+#define PROBE3_CLEAR()
+#define PROBE4_CLEAR()
+#define PROBE5_CLEAR()
+#define PROBE6_CLEAR()
+#define PROBE7_CLEAR()
+#define PROBE8_CLEAR()
+
+/* No RNG on the host, the time will do */
+static inline uint32_t board_seed(void) { return (uint32_t)time(NULL) * 2654435761U; }
+
+/* No LEDs on the host */
+#define LED_ON()
+#define LED_OFF()
+
+#endif /* HOST_BOARD_H_ */
@@ -0,0 +1,250 @@
+/**
+ * @file delay_check.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host check of the delay line reads and block copies (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Runs an impulse through a float and a Q15 line (dsp/delay.c) read with each of the
+ * fractional reads at a few delays t, whole and between samples, and measures the
+ * delay of the response two ways: its centroid, which is the group delay at DC, and
+ * its phase delay at 1 kHz, from the DFT at that frequency.  Both should be t, to
+ * within the read's own phase error, which is well under TOLERANCE samples that low.
+ *
+ * Then delay_write_block() and delay_read_block() are run against delay_write() and
+ * delay_tap() a sample at a time, on lines started just short of both the ring's
+ * wrap and the write counter's, with blocks that straddle them.  The blocks should
+ * match exactly.
+ *
+ * Prints the worst error for each and exits with EXIT_FAILURE if any is over
+ * TOLERANCE, or a block differs.
+ *
+ *   STM32F411-Blackpill-host-delay-check
+ */
+#include <complex.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "delay.h"
+
+#define N 4096
+#define BITS 12
+#define FSR 48000.0
+#define FREQUENCY 1000.0
+#define TOLERANCE 0.01 /* Samples */
+
+typedef enum
+{
+	READ_LINEAR,
+	READ_LAGRANGE,
+	READ_ALLPASS,
+} read_t;
+
+static float buffer[DELAY_SIZE(BITS)];
+static int16_t buffer_q15[DELAY_SIZE(BITS)];
+static float response[N];
+
+/**
+ * @brief The impulse response of a read at t, from a float line or a Q15 one.
+ */
+static void impulse(read_t read, float t, bool q15)
+{
+	delay_t d;
+	delay_q15_t d_q15;
+	float state = 0.0f;
+
+	delay_init(&d, buffer, DELAY_SIZE(BITS));
+	delay_q15_init(&d_q15, buffer_q15, DELAY_SIZE(BITS));
+
+	for (int i = 0; i < N; i++)
+	{
+		float x = i == 0 ? 0.5f : 0.0f; /* Exact in Q15 */
+
+		switch (read)
+		{
+		case READ_LINEAR:
+			response[i] = q15 ? delay_q15_read_linear(&d_q15, t) : delay_read_linear(&d, t);
+			break;
+		case READ_LAGRANGE:
+			response[i] = q15 ? delay_q15_read_lagrange(&d_q15, t) : delay_read_lagrange(&d, t);
+			break;
+		default:
+			response[i] = q15 ? delay_q15_read_allpass(&d_q15, t, &state) : delay_read_allpass(&d, t, &state);
+			break;
+		}
+		response[i] *= 2.0f;
+
+		if (q15)
+		{
+			delay_q15_write(&d_q15, x);
+		}
+		else
+		{
+			delay_write(&d, x);
+		}
+	}
+}
+
+/**
+ * @brief The larger of the group delay at DC and the phase delay at FREQUENCY, less t.
+ */
+static double delay_error(double t)
+{
+	double sum = 0.0;
+	double moment = 0.0;
+	double w = 2.0 * M_PI * FREQUENCY / FSR;
+	double complex h = 0.0;
+
+	for (int i = 0; i < N; i++)
+	{
+		sum += response[i];
+		moment += i * (double)response[i];
+		h += response[i] * cexp(-I * w * i);
+	}
+
+	/* Turned back by the expected delay, the phase left over is the error */
+	double group = fabs(moment / sum - t);
+	double phase = fabs(carg(h * cexp(I * w * t)) / w);
+
+	return group > phase ? group : phase;
+}
+
+/**
+ * @brief Block copies against a sample at a time, starting write samples in.
+ * @return The number of samples that differ
+ */
+static int blocks(uint32_t write, uint32_t n, size_t frames, bool q15)
+{
+	static float line[DELAY_SIZE(8)];
+	static float line_ref[DELAY_SIZE(8)];
+	static int16_t line_q15[DELAY_SIZE(8)];
+	static int16_t line_q15_ref[DELAY_SIZE(8)];
+	static float in[DELAY_SIZE(8)];
+	static float out[DELAY_SIZE(8)];
+	static float ref[DELAY_SIZE(8)];
+	delay_t d, r;
+	delay_q15_t d_q15, r_q15;
+	int wrong = 0;
+
+	delay_init(&d, line, DELAY_SIZE(8));
+	delay_init(&r, line_ref, DELAY_SIZE(8));
+	delay_q15_init(&d_q15, line_q15, DELAY_SIZE(8));
+	delay_q15_init(&r_q15, line_q15_ref, DELAY_SIZE(8));
+	d.write = r.write = d_q15.write = r_q15.write = write;
+
+	/* Enough blocks to go round the ring a few times */
+	for (int b = 0; b < 16; b++)
+	{
+		for (size_t i = 0; i < frames; i++)
+		{
+			in[i] = (float)rand() / RAND_MAX - 0.5f;
+		}
+
+		if (q15)
+		{
+			delay_q15_read_block(&d_q15, out, n, frames);
+			delay_q15_write_block(&d_q15, in, frames);
+			for (size_t i = 0; i < frames; i++)
+			{
+				ref[i] = delay_q15_tap(&r_q15, n);
+				delay_q15_write(&r_q15, in[i]);
+			}
+			wrong += d_q15.write != r_q15.write;
+		}
+		else
+		{
+			delay_read_block(&d, out, n, frames);
+			delay_write_block(&d, in, frames);
+			for (size_t i = 0; i < frames; i++)
+			{
+				ref[i] = delay_tap(&r, n);
+				delay_write(&r, in[i]);
+			}
+			wrong += d.write != r.write;
+		}
+
+		for (size_t i = 0; i < frames; i++)
+		{
+			wrong += out[i] != ref[i];
+		}
+	}
+	return wrong;
+}
+
+int main(void)
+{
+	static const struct
+	{
+		const char *name;
+		read_t read;
+		float lowest; /* Shortest delay the read takes */
+	} reads[] = {
+			{"linear", READ_LINEAR, 1.0f},
+			{"lagrange", READ_LAGRANGE, 2.0f},
+			{"allpass", READ_ALLPASS, 1.5f},
+	};
+	static const float times[] = {1.0f, 1.5f, 2.0f, 3.25f, 10.5f, 100.75f, 1000.9f};
+	static const struct
+	{
+		uint32_t write;
+		uint32_t n;
+		size_t frames;
+	} runs[] = {
+			{200, 128, 128}, /* Straddles the ring */
+			{250, 256, 100}, /* Longest delay */
+			{0xFFFFFF80U, 160, 96}, /* Straddles the write counter */
+			{0xFFFFFFF0U, 37, 32},
+	};
+	bool pass = true;
+	char name[64];
+
+	printf("%-32s %12s\n", "read", "delay error");
+
+	for (int q15 = 0; q15 < 2; q15++)
+	{
+		for (size_t r = 0; r < sizeof(reads) / sizeof(reads[0]); r++)
+		{
+			double worst = 0.0;
+
+			for (size_t t = 0; t < sizeof(times) / sizeof(times[0]); t++)
+			{
+				if (times[t] < reads[r].lowest)
+				{
+					continue;
+				}
+				impulse(reads[r].read, times[t], q15);
+
+				double error = delay_error(times[t]);
+
+				worst = error > worst ? error : worst;
+			}
+
+			snprintf(name, sizeof(name), "%s %s", q15 ? "q15" : "float", reads[r].name);
+			printf("%-32s %12.2e  %s\n", name, worst, worst <= TOLERANCE ? "ok" : "FAIL");
+			pass &= worst <= TOLERANCE;
+		}
+	}
+
+	printf("\n%-32s %12s\n", "block", "wrong");
+
+	for (int q15 = 0; q15 < 2; q15++)
+	{
+		for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++)
+		{
+			int wrong = blocks(runs[r].write, runs[r].n, runs[r].frames, q15);
+
+			snprintf(name, sizeof(name), "%s %zu at %u from %08X", q15 ? "q15" : "float", runs[r].frames, runs[r].n,
+							 runs[r].write);
+			printf("%-32s %12d  %s\n", name, wrong, wrong == 0 ? "ok" : "FAIL");
+			pass &= wrong == 0;
+		}
+	}
+
+	printf("%s\n", pass ? "all within tolerance" : "FAILED");
+	return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file host_clock.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Monotonic nanosecond clock shared by the host stand-ins and tools (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The one time base on the host: the simulated DMA stream paces itself by it, the
+ * profiler's stand-in for the cycle counter is its low 32 bits, and the benchmarks
+ * time their loops with it.
+ */
+#include <time.h>
+#include "host_clock.h"
+
+/**
+ * @brief Nanoseconds from CLOCK_MONOTONIC, 64-bit so long runs don't wrap.
+ *
+ * @return int64_t Nanoseconds
+ */
+int64_t host_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file host_clock.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Monotonic nanosecond clock shared by the host stand-ins and tools (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef HOST_CLOCK_H_
+#define HOST_CLOCK_H_
+
+#include <stdint.h>
+
+int64_t host_now_ns(void);
+
+#endif /* HOST_CLOCK_H_ */
@@ -0,0 +1,417 @@
+/**
+ * @file osc_bench.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host benchmark of the oscillators (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Times a block of SAMPLE_BLOCK_SIZE samples of each shape in dsp/osc_blep.c, and of
+ * the wavetable oscillator in dsp/wavetable.c with each interpolation, with and
+ * without a morph, of each sine backend in dsp/sine.c and of the fixed-point
+ * phasors in dsp/phasor.c.  The phasors are timed to Q31 blocks and to Q15.  Each is timed on its own and summed into a bank of voices, and
+ * the time per sample per voice printed.  The struct-of-arrays voice bank in
+ * dsp/voice_bank.c is timed with 8, 16 and 32 voices, and the FM voice in dsp/fm.c
+ * with each algorithm, every operator sounding.  The noise generators in dsp/noise.c
+ * are timed to float and Q31 blocks, and the additive voice in dsp/additive.c with
+ * 16, 32 and 64 partials.  The 7 saw supersaw in dsp/unison.c is timed against 7
+ * separate osc_blep_mix() calls, which only make mono.  A saw gliding (see ramp.h) is
+ * timed against one settled, and a ramped gain against a constant one.
+ * These are host figures, for the target put the render in a profiler section (see
+ * main.c) and divide its mean cycles by the block size.
+ *
+ *   STM32F411-Blackpill-host-osc-bench [iterations]
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "additive.h"
+#include "audio.h"
+#include "fm.h"
+#include "host_clock.h"
+#include "noise.h"
+#include "osc_blep.h"
+#include "phasor.h"
+#include "ramp.h"
+#include "sine.h"
+#include "unison.h"
+#include "voice_bank.h"
+#include "wavetable.h"
+
+#define FRAMES SAMPLE_BLOCK_SIZE
+#define VOICES 8
+#define FSR 48000.0f
+
+static float out[FRAMES];
+static float out_right[FRAMES];
+static int32_t out_q31[FRAMES];
+static int16_t out_q15[FRAMES];
+static int32_t bus[FRAMES];
+
+static double time_blep_ns(osc_shape_t shape, int voices, long iterations)
+{
+	osc_blep_t bank[VOICES];
+	double start;
+
+	for (int v = 0; v < voices; v++)
+	{
+		/* Spread over a couple of octaves, high enough to hit plenty of residuals */
+		osc_blep_init(&bank[v], shape, 220.0f * (1.0f + 0.37f * v), FSR);
+		osc_blep_set_width(&bank[v], 0.3f);
+	}
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (voices == 1)
+		{
+			osc_blep_render(&bank[0], out, FRAMES);
+		}
+		else
+		{
+			for (int v = 0; v < voices; v++)
+			{
+				osc_blep_mix(&bank[v], out, FRAMES, 1.0f / VOICES);
+			}
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES * voices);
+}
+
+static double time_wavetable_ns(wavetable_interp_t interp, float morph, int voices, long iterations)
+{
+	wavetable_osc_t bank[VOICES];
+	double start;
+
+	for (int v = 0; v < voices; v++)
+	{
+		wavetable_init(&bank[v], interp, 220.0f * (1.0f + 0.37f * v), FSR);
+		wavetable_set_morph(&bank[v], morph);
+	}
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (voices == 1)
+		{
+			wavetable_render(&bank[0], out, FRAMES);
+		}
+		else
+		{
+			for (int v = 0; v < voices; v++)
+			{
+				wavetable_mix(&bank[v], out, FRAMES, 1.0f / VOICES);
+			}
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES * voices);
+}
+
+static double time_sine_ns(sine_backend_t backend, int voices, long iterations)
+{
+	sine_osc_t bank[VOICES];
+	double start;
+
+	for (int v = 0; v < voices; v++)
+	{
+		sine_init(&bank[v], backend, 220.0f * (1.0f + 0.37f * v), FSR);
+	}
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (voices == 1)
+		{
+			sine_render(&bank[0], out, FRAMES);
+		}
+		else
+		{
+			for (int v = 0; v < voices; v++)
+			{
+				sine_mix(&bank[v], out, FRAMES, 1.0f / VOICES);
+			}
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES * voices);
+}
+
+static double time_phasor_ns(phasor_shape_t shape, bool q15, long iterations)
+{
+	phasor_t p;
+	double start;
+
+	phasor_init(&p, shape, 220.0f, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (q15)
+		{
+			phasor_render_q15(&p, out_q15, FRAMES);
+		}
+		else
+		{
+			phasor_render_q31(&p, out_q31, FRAMES);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_voice_bank_ns(phasor_shape_t shape, int voices, long iterations)
+{
+	static voice_bank_t bank;
+	double start;
+
+	voice_bank_init(&bank, shape);
+	for (int v = 0; v < voices; v++)
+	{
+		voice_bank_start(&bank, 220.0f * (1.0f + 0.37f * v), 1.0f / voices, FSR);
+	}
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		for (size_t n = 0; n < FRAMES; n++)
+		{
+			bus[n] = 0;
+		}
+		voice_bank_render(&bank, bus, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES * voices);
+}
+
+static double time_fm_ns(fm_algorithm_id_t algorithm, long iterations)
+{
+	static fm_voice_t voice;
+	double start;
+
+	fm_init(&voice, algorithm, 220.0f, FSR);
+	for (int n = 0; n < FM_OPERATORS; n++)
+	{
+		fm_set_operator(&voice, n, 1.0f + n, 0.5f);
+	}
+	fm_set_feedback(&voice, 0.3f);
+	fm_note_on(&voice);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		fm_render(&voice, out, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_noise_ns(noise_type_t type, bool q31, long iterations)
+{
+	noise_t noise;
+	double start;
+
+	noise_init(&noise, type, 1);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (q31)
+		{
+			noise_render_q31(&noise, out_q31, FRAMES);
+		}
+		else
+		{
+			noise_render(&noise, out, FRAMES);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_additive_ns(int partials, long iterations)
+{
+	static additive_t voice;
+	double start;
+
+	/* Low enough that none are culled */
+	additive_init(&voice, 110.0f, FSR);
+	for (int n = 0; n < partials; n++)
+	{
+		additive_set_partial(&voice, n, 1.0f + n * 0.5f, 1.0f / partials, 2.0f);
+	}
+	additive_note_on(&voice);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		additive_render(&voice, out, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES * partials);
+}
+
+static double time_unison_ns(long iterations)
+{
+	static unison_t osc;
+	double start;
+
+	unison_init(&osc, 7, 220.0f, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		unison_render(&osc, out, out_right, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_glide_ns(osc_shape_t shape, bool gliding, long iterations)
+{
+	osc_blep_t osc;
+	double start;
+
+	osc_blep_init(&osc, shape, 220.0f, FSR);
+	osc_blep_set_glide(&osc, RAMP_LINEAR, 1000.0f, FSR); /* Never arrives */
+	if (gliding)
+	{
+		osc_blep_set_frequency(&osc, 880.0f, FSR);
+	}
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		osc_blep_render(&osc, out, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_ramp_ns(bool ramping, long iterations)
+{
+	ramp_t gain;
+	double start;
+
+	ramp_init(&gain, RAMP_LINEAR, 0.5f, 1000.0f, FSR);
+	if (ramping)
+	{
+		ramp_set_target(&gain, 0.25f);
+	}
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		ramp_apply(&gain, out, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+int main(int argc, char *argv[])
+{
+	long iterations = argc > 1 ? atol(argv[1]) : 20000;
+	static const char *names[] = {"saw", "pulse", "triangle"};
+
+	printf("%u samples per block\n", FRAMES);
+	printf("%-18s %13s %19s\n", "oscillator", "ns/sample", "ns/sample/voice x8");
+
+	for (int shape = OSC_SAW; shape <= OSC_TRIANGLE; shape++)
+	{
+		double single = time_blep_ns((osc_shape_t)shape, 1, iterations);
+		double bank = time_blep_ns((osc_shape_t)shape, VOICES, iterations / VOICES);
+
+		printf("%-18s %13.3f %19.3f\n", names[shape], single, bank);
+	}
+
+	for (int interp = WAVETABLE_LINEAR; interp <= WAVETABLE_CUBIC; interp++)
+	{
+		for (int morph = 0; morph < 2; morph++)
+		{
+			double single = time_wavetable_ns((wavetable_interp_t)interp, morph ? 2.5f : 2.0f, 1, iterations);
+			double bank = time_wavetable_ns((wavetable_interp_t)interp, morph ? 2.5f : 2.0f, VOICES, iterations / VOICES);
+
+			printf("wavetable %-6s %s %13.3f %19.3f\n", interp == WAVETABLE_LINEAR ? "linear" : "cubic", morph ? "M" : " ", single, bank);
+		}
+	}
+	printf("M = morphing between two frames\n");
+
+	static const char *sines[] = {"sine table 256", "sine table 1024", "sine polynomial", "sine rotator"};
+
+	for (int backend = SINE_TABLE_256; backend <= SINE_ROTATOR; backend++)
+	{
+		double single = time_sine_ns((sine_backend_t)backend, 1, iterations);
+		double bank = time_sine_ns((sine_backend_t)backend, VOICES, iterations / VOICES);
+
+		printf("%-18s %13.3f %19.3f\n", sines[backend], single, bank);
+	}
+
+	static const char *phasors[] = {"phasor saw", "phasor square", "phasor triangle", "phasor sine"};
+
+	printf("\n%-18s %13s %19s\n", "", "Q31 ns/sample", "Q15 ns/sample");
+	for (int shape = PHASOR_SAW; shape <= PHASOR_SINE; shape++)
+	{
+		double q31 = time_phasor_ns((phasor_shape_t)shape, false, iterations);
+		double q15 = time_phasor_ns((phasor_shape_t)shape, true, iterations);
+
+		printf("%-18s %13.3f %19.3f\n", phasors[shape], q31, q15);
+	}
+
+	static const int counts[] = {8, 16, VOICE_BANK_MAX};
+
+	printf("\n%-18s %13s %13s %13s\n", "voice bank", "ns/v/s x8", "ns/v/s x16", "ns/v/s x32");
+	for (int shape = PHASOR_SAW; shape <= PHASOR_SINE; shape++)
+	{
+		printf("%-18s", phasors[shape] + 7);
+		for (int c = 0; c < 3; c++)
+		{
+			printf(" %13.3f", time_voice_bank_ns((phasor_shape_t)shape, counts[c], iterations / counts[c] * 4));
+		}
+		printf("\n");
+	}
+	printf("ns/v/s = ns per voice per sample, on the target voices per MHz = 1 / (fsr x cycles/v/s)\n");
+
+	static const char *algorithms[] = {"4 stack", "4 two stacks", "4 branch", "4 one to three", "4 parallel",
+		"6 DX 1", "6 DX 5", "6 DX 7", "6 DX 22", "6 DX 32"};
+
+	printf("\n%-18s %13s\n", "FM algorithm", "ns/sample");
+	for (int alg = 0; alg < FM_ALGORITHMS; alg++)
+	{
+		printf("%-18s %13.3f\n", algorithms[alg], time_fm_ns((fm_algorithm_id_t)alg, iterations));
+	}
+
+	static const char *noises[] = {"noise white", "noise pink", "noise LFSR", "noise LFSR short"};
+
+	printf("\n%-18s %13s %19s\n", "", "ns/sample", "Q31 ns/sample");
+	for (int type = NOISE_WHITE; type <= NOISE_LFSR_SHORT; type++)
+	{
+		double flt = time_noise_ns((noise_type_t)type, false, iterations);
+		double q31 = time_noise_ns((noise_type_t)type, true, iterations);
+
+		printf("%-18s %13.3f %19.3f\n", noises[type], flt, q31);
+	}
+
+	printf("\n%-18s %13s %13s %13s\n", "additive", "ns/p/s x16", "ns/p/s x32", "ns/p/s x64");
+	printf("%-18s", "partials");
+	for (int partials = 16; partials <= ADDITIVE_PARTIALS; partials *= 2)
+	{
+		printf(" %13.3f", time_additive_ns(partials, iterations / partials * 8));
+	}
+	printf("\nns/p/s = ns per partial per sample\n");
+
+	printf("\n%-18s %13.3f\n", "unison x7 stereo", time_unison_ns(iterations));
+	printf("%-18s %13.3f\n", "7 x saw mix mono", 7.0 * time_blep_ns(OSC_SAW, 7, iterations / 7));
+
+	printf("\n%-18s %13s %13s\n", "ramp", "settled", "ramping");
+	printf("%-18s %13.3f %13.3f\n", "saw glide", time_glide_ns(OSC_SAW, false, iterations),
+				 time_glide_ns(OSC_SAW, true, iterations));
+	printf("%-18s %13.3f %13.3f\n", "triangle glide", time_glide_ns(OSC_TRIANGLE, false, iterations),
+				 time_glide_ns(OSC_TRIANGLE, true, iterations));
+	printf("%-18s %13.3f %13.3f\n", "gain", time_ramp_ns(false, iterations), time_ramp_ns(true, iterations));
+
+	return EXIT_SUCCESS;
+}
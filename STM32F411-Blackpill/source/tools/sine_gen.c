@@ -0,0 +1,70 @@
+/**
+ * @file sine_gen.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Build-time generator for the sine oscillator's tables (runs on the build machine)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Writes the C source for sine_table_256[], sine_table_1024[] and the Q15
+ * sine_table_q15[] (see dsp/sine.h), one cycle each with the first sample repeated at
+ * the end for the interpolation.
+ *
+ *   sine_gen <output.c>
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PI 3.14159265358979323846
+
+static void table(FILE *out, int size)
+{
+	fprintf(out, "const float sine_table_%d[%d + 1] = {\n\t", size, size);
+	for (int i = 0; i <= size; i++)
+	{
+		fprintf(out, "%.8ef%s", sin(2.0 * PI * (i % size) / size), i == size ? "" : (i + 1) % 6 ? ", " : ",\n\t");
+	}
+	fprintf(out, "};\n");
+}
+
+static void table_q15(FILE *out, int size)
+{
+	fprintf(out, "const int16_t sine_table_q15[%d + 1] = {\n\t", size);
+	for (int i = 0; i <= size; i++)
+	{
+		fprintf(out, "%ld%s", lrint(32767.0 * sin(2.0 * PI * (i % size) / size)), i == size ? "" : (i + 1) % 12 ? ", " : ",\n\t");
+	}
+	fprintf(out, "};\n");
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *out;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s <output.c>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	out = fopen(argv[1], "w");
+	if (out == NULL)
+	{
+		fprintf(stderr, "Unable to create %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(out, "/* Generated by tools/sine_gen.c, do not edit */\n");
+	fprintf(out, "#include \"sine.h\"\n\n");
+	table(out, 256);
+	fprintf(out, "\n");
+	table(out, 1024);
+	fprintf(out, "\n");
+	table_q15(out, 1024);
+
+	return fclose(out) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
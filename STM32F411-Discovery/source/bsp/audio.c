@@ -15,6 +15,11 @@
  */
 #include "audio.h"
 
+/* The streaming buffer and the ring segment the DMA is sending (double-buffer mode) */
+static audio_config_t *stream_config;
+static int16_t *stream_buffer;
+static uint8_t stream_segment;
+
 /* Control Memory Address Pointers (registers) for onboard Audio DAC */
 #define CS43L22_REG_CHIP_ID 0x01
 #define CS43L22_REG_POWER_CTL1 0x02
@@ -79,19 +84,13 @@
  *    VAL = ((((86000000 / 256) * 10)/44100)+5) / 10 = 7
  *    ODD = 1
  *    DIV = 7-1 /2 = 3
- * 
- * NOTE: You must set the WORD_LENGTH #define in audio.h to the correct buffer size to match the
- * bits value here.
  */
 audio_config_t configs[] =
-{								
-#if SAMPLE_RESOLUTION == 16
-	{.N = 271, .R = 2, .DIV = 6, .ODD = 0, .MCKOE = 1, .bits = 32, .type = I2S_44_MCKOE_32, .fsr = 44108.0f},
-	{.N = 258, .R=  3, .DIV =` 3, .ODD = 0, .MCKOE = 1, .bits = 16, .type = I2S_48_MCKOE_16, .fsr = 47991.0f},
-#else
+{
+	{.N = 271, .R = 2, .DIV = 6, .ODD = 0, .MCKOE = 1, .bits = 16, .type = I2S_44_MCKOE_16, .fsr = 44108.0f},
+	{.N = 258, .R = 3, .DIV = 3, .ODD = 1, .MCKOE = 1, .bits = 16, .type = I2S_48_MCKOE_16, .fsr = 47991.0f},
 	{.N = 271, .R = 2, .DIV = 6, .ODD = 0, .MCKOE = 1, .bits = 32, .type = I2S_44_MCKOE_32, .fsr = 44108.0f},
-	{.N = 258, .R=  3, .DIV = 3, .ODD = 1, .MCKOE = 1, .bits = 32, .type = I2S_48_MCKOE_32, .fsr = 47991.0f}				
-#endif	
+	{.N = 258, .R = 3, .DIV = 3, .ODD = 1, .MCKOE = 1, .bits = 32, .type = I2S_48_MCKOE_32, .fsr = 47991.0f}
 };
 
 
@@ -148,17 +147,56 @@ static void cs43l22_init(void)
 
 
 /**
- * @brief Enables I2S audio stream using DMA circular buffering.
+ * @brief Enables I2S audio stream using DMA circular buffering, SAMPLE_BLOCK_SIZE frames
+ * per refill in two halves.
  *
- * @param audio_buffer The audio buffer
+ * @param audio_buffer The audio buffer (AUDIO_BUF_MAX)
  * @param audio_mode The audio mode (this determines I2S clock configuration)
  * @return audio_config_t*  The config from LUT (the caller needs this)
  */
 audio_config_t *audio_streaming_run(int16_t audio_buffer[], audio_mode_t audio_mode)
+{
+	return audio_streaming_start(audio_buffer, audio_mode, SAMPLE_BLOCK_SIZE, 2);
+}
+
+/**
+ * @brief Enables I2S audio stream with a given latency.
+ * @details The buffer is split into a ring of segments of block frames each, the DMA
+ * asks for a segment to be refilled as soon as it has sent it.  Two segments use the
+ * DMA's half/complete interrupts as before.  More than two use double-buffer mode, the
+ * DMA flips between the M0AR and M1AR targets and the free one is pointed at the next
+ * segment from the TC interrupt (see audio_segment_done()).  A refill then has up to
+ * segments - 1 block periods to complete.
+ *
+ * block is clamped to SAMPLE_BLOCK_MIN..SAMPLE_BLOCK_MAX and segments to what fits in
+ * AUDIO_RING_FRAMES, e.g. 16 x 32, 64 x 8, 128 x 4 or 256 x 2.  May be called again to
+ * change the latency, the stream is stopped and restarted.
+ *
+ * @param audio_buffer The audio buffer (AUDIO_BUF_MAX)
+ * @param audio_mode The audio mode (this determines I2S clock configuration)
+ * @param block Frames per refill, 16, 32, 64, 128 or 256
+ * @param segments Segments in the ring, at least 2
+ * @return audio_config_t*  The config from LUT (the caller needs this)
+ */
+audio_config_t *audio_streaming_start(int16_t audio_buffer[], audio_mode_t audio_mode, uint16_t block, uint8_t segments)
 {
 	/* Lookup the configuration details for the requested mode */
 	audio_config_t *config = &configs[audio_mode];
 
+	/* DMA interrupt off while the ring and the stream are set up again */
+	NVIC_DisableIRQ(I2S_DMA_IRQ);
+
+	/* Fit the ring into the static buffer, for this many bits */
+	audio_layout(config, block, segments);
+	segments = config->segments;
+
+	stream_config = config;
+	stream_buffer = audio_buffer;
+	stream_segment = 0;
+
+	/* Start counting xruns afresh */
+	audio_stats_init(audio_buffer, config);
+
 	/* Peripheral clocks on */
 	LL_APB1_GRP1_EnableClock(I2S_SPI_CLK);
 	LL_AHB1_GRP1_EnableClock(I2S_DMA_CLK);
@@ -182,6 +220,14 @@ audio_config_t *audio_streaming_run(int16_t audio_buffer[], audio_mode_t audio_m
 	while (LL_DMA_IsEnabledStream(I2S_DMA, I2S_DMA_STREAM))
 		;
 
+	/* Stopping a running stream sets TC, clear it and the rest so a restart doesn't
+	   take a refill it hasn't earned */
+	LL_DMA_ClearFlag_TC5(I2S_DMA);
+	LL_DMA_ClearFlag_HT5(I2S_DMA);
+	LL_DMA_ClearFlag_TE5(I2S_DMA);
+	LL_DMA_ClearFlag_FE5(I2S_DMA);
+	LL_DMA_ClearFlag_DME5(I2S_DMA);
+
 	/* I2S standard config */
 	LL_I2S_SetStandard(I2S_SPI, LL_I2S_STANDARD_PHILIPS);
 	LL_I2S_SetTransferMode(I2S_SPI, LL_I2S_MODE_MASTER_TX);
@@ -210,13 +256,11 @@ audio_config_t *audio_streaming_run(int16_t audio_buffer[], audio_mode_t audio_m
 	/* DMA Source and target addresses */
 	LL_DMA_ConfigAddresses(I2S_DMA, I2S_DMA_STREAM, (uint32_t)audio_buffer, LL_SPI_DMA_GetRegAddr(I2S_SPI), LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
 
-	/* DMA transfer length */
-	LL_DMA_SetDataLength(I2S_DMA, I2S_DMA_STREAM, AUDIO_BUF_DBL);
-
-	/* DMA controller configuration */
-	LL_DMA_ConfigTransfer(I2S_DMA,I2S_DMA_STREAM,
+	/* DMA controller configuration, 24/32-bit frames are read a word at a time and the FIFO
+	   unpacks them to halfwords for the SPI.  NDTR still counts halfwords. */
+	LL_DMA_ConfigTransfer(I2S_DMA, I2S_DMA_STREAM,
 												LL_DMA_PRIORITY_HIGH |
-														LL_DMA_MDATAALIGN_HALFWORD |
+														(config->bits == 16 ? LL_DMA_MDATAALIGN_HALFWORD : LL_DMA_MDATAALIGN_WORD) |
 														LL_DMA_PDATAALIGN_HALFWORD |
 														LL_DMA_DIRECTION_MEMORY_TO_PERIPH |
 														LL_DMA_FIFOMODE_ENABLE |
@@ -225,17 +269,30 @@ audio_config_t *audio_streaming_run(int16_t audio_buffer[], audio_mode_t audio_m
 														LL_DMA_PERIPH_NOINCREMENT |
 														LL_DMA_MODE_CIRCULAR);
 
+	if (segments == 2)
+	{
+		/* Circular over the whole buffer, a refill at half and full */
+		LL_DMA_DisableDoubleBufferMode(I2S_DMA, I2S_DMA_STREAM);
+		LL_DMA_SetDataLength(I2S_DMA, I2S_DMA_STREAM, config->segment * 2);
+		LL_DMA_EnableIT_HT(I2S_DMA, I2S_DMA_STREAM); /* Transfer half complete interrupt */
+	}
+	else
+	{
+		/* Double-buffer, one segment per target starting with the first two */
+		LL_DMA_EnableDoubleBufferMode(I2S_DMA, I2S_DMA_STREAM);
+		LL_DMA_SetMemory1Address(I2S_DMA, I2S_DMA_STREAM, (uint32_t)(audio_buffer + config->segment));
+		LL_DMA_SetCurrentTargetMem(I2S_DMA, I2S_DMA_STREAM, LL_DMA_CURRENTTARGETMEM0);
+		LL_DMA_SetDataLength(I2S_DMA, I2S_DMA_STREAM, config->segment);
+		LL_DMA_DisableIT_HT(I2S_DMA, I2S_DMA_STREAM);
+	}
+
 	/* Request that we're sent interrupts */
 	LL_DMA_EnableIT_TC(I2S_DMA, I2S_DMA_STREAM); /* Transfer complete interrupt */
-	LL_DMA_EnableIT_HT(I2S_DMA, I2S_DMA_STREAM); /* Transfer half complete interrupt */
 	LL_DMA_EnableIT_TE(I2S_DMA, I2S_DMA_STREAM); /* Transfer error interrupt */
 
 	/* DMA Tx Enable */
 	LL_SPI_EnableDMAReq_TX(I2S_SPI);
 
-	/* Enable DMA interrupt */
-	NVIC_EnableIRQ(I2S_DMA_IRQ);
-
 	/* I2S PLL on */
 	LL_RCC_PLLI2S_Enable();
 	while (!LL_RCC_PLLI2S_IsReady())
@@ -251,9 +308,69 @@ audio_config_t *audio_streaming_run(int16_t audio_buffer[], audio_mode_t audio_m
 	while (!LL_DMA_IsEnabledStream(I2S_DMA, I2S_DMA_STREAM))
 		;
 
+	/* Enable DMA interrupt, last so it sees only the new stream */
+	NVIC_EnableIRQ(I2S_DMA_IRQ);
+
 	/* Start the DAC, according to datasheet this needs to be done after I2S is running */
 	cs43l22_init();
 
 	return config;
 }
 
+/**
+ * @brief Moves the ring on, call from the DMA IRQ handler on HT or TC.
+ * @details In double-buffer mode the DMA has already switched to the other target,
+ * which holds the next segment.  The target it has just finished with is pointed at
+ * the segment after that.
+ *
+ * @param complete true for TC, false for HT (only used with two segments)
+ * @return int16_t* The segment just sent, which is to be refilled
+ */
+int16_t *audio_segment_done(bool complete)
+{
+	uint8_t segments = stream_config->segments;
+	uint8_t done = stream_segment;
+
+	if (segments == 2)
+	{
+		return complete ? stream_buffer + stream_config->segment : stream_buffer;
+	}
+
+	stream_segment = (done + 1) % segments;
+
+	uint32_t next = (uint32_t)(stream_buffer + ((done + 2) % segments) * stream_config->segment);
+
+	if (LL_DMA_GetCurrentTargetMem(I2S_DMA, I2S_DMA_STREAM) == LL_DMA_CURRENTTARGETMEM1)
+	{
+		LL_DMA_SetMemoryAddress(I2S_DMA, I2S_DMA_STREAM, next);
+	}
+	else
+	{
+		LL_DMA_SetMemory1Address(I2S_DMA, I2S_DMA_STREAM, next);
+	}
+
+	return stream_buffer + done * stream_config->segment;
+}
+
+/**
+ * @brief Where the DMA is reading from.
+ * @details NDTR runs a FIFO's worth ahead of the I2S output.
+ *
+ * @return uint32_t Halfword offset into the audio buffer
+ */
+uint32_t audio_stream_position(void)
+{
+	uint32_t left = LL_DMA_GetDataLength(I2S_DMA, I2S_DMA_STREAM);
+
+	if (stream_config->segments == 2)
+	{
+		return stream_config->segment * 2 - left;
+	}
+
+	/* Offset of the segment in the current target */
+	int16_t *target = (int16_t *)(LL_DMA_GetCurrentTargetMem(I2S_DMA, I2S_DMA_STREAM) == LL_DMA_CURRENTTARGETMEM1
+																		? LL_DMA_GetMemory1Address(I2S_DMA, I2S_DMA_STREAM)
+																		: LL_DMA_GetMemoryAddress(I2S_DMA, I2S_DMA_STREAM));
+
+	return (target - stream_buffer) + stream_config->segment - left;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file audio_stats.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Refill queue and underrun (xrun) detection for the DMA ring
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The DMA IRQ handler queues each segment it has finished with audio_refill_request(),
+ * the super-loop (or PendSV) takes them in order with audio_refill_next() and hands them
+ * back with audio_refill_done().  With more than two segments the refills can fall up
+ * to segments - 1 blocks behind before anything is heard.
+ *
+ * There are two ways a refill can miss its deadline:
+ *
+ * 1. The DMA asks for a segment while every other segment is still waiting, it is
+ *    already sending one that was never refilled.  The oldest request is dropped.
+ *
+ * 2. The refill completes, but only after the DMA has wrapped around and started
+ *    sending the segment that was being written.  audio_refill_done() catches this
+ *    by checking audio_stream_position() against the segment just written.  NDTR runs
+ *    a FIFO's worth ahead of the I2S output so this errs on the safe side.
+ *
+ * Either way the listener hears a glitch, both are counted and time stamped.
+ */
+#include "audio.h"
+#include "profile.h"
+
+/* Twice the ring so the slot being written is never the one being read */
+#define QUEUE_SIZE (AUDIO_SEGMENTS_MAX * 2)
+
+static volatile audio_stats_t stats;
+static int16_t *stream_buffer;
+static uint16_t segment_size;
+static uint8_t segments;
+
+/* Written by the IRQ handler (requested) and the refill (completed) only */
+static int16_t *volatile queue[QUEUE_SIZE];
+static volatile uint32_t requested;
+static volatile uint32_t completed;
+
+/**
+ * @brief Clears the queue and counters, called by audio_streaming_start().
+ *
+ * @param audio_buffer The ring buffer being streamed
+ * @param config Ring layout
+ */
+void audio_stats_init(int16_t audio_buffer[], audio_config_t *config)
+{
+	stream_buffer = audio_buffer;
+	segment_size = config->segment;
+	segments = config->segments;
+	requested = 0;
+	completed = 0;
+	audio_stats_reset();
+}
+
+/**
+ * @brief Queues a segment for refill, call from the DMA IRQ handler.
+ *
+ * @param segment The segment just sent (from audio_segment_done())
+ */
+void audio_refill_request(int16_t *segment)
+{
+	stats.requests++;
+
+	if (requested - completed >= segments - 1U)
+	{
+		stats.xruns++;
+		stats.last_xrun = profile_now();
+	}
+
+	queue[requested % QUEUE_SIZE] = segment;
+	requested++;
+}
+
+/**
+ * @brief The oldest segment waiting for a refill.
+ *
+ * @return int16_t* The segment, or NULL if they are all up to date
+ */
+int16_t *audio_refill_next(void)
+{
+	uint32_t latest = requested;
+
+	if (latest == completed)
+	{
+		return NULL;
+	}
+
+	/* With every segment waiting the oldest is being sent stale already, the same
+	   test as the xrun in audio_refill_request() */
+	if (latest - completed >= segments)
+	{
+		completed = latest - (segments - 1U);
+	}
+
+	return queue[completed % QUEUE_SIZE];
+}
+
+/**
+ * @brief Marks a refill complete and checks it against the DMA read position.
+ *
+ * @param segment The segment that was just refilled
+ */
+void audio_refill_done(int16_t *segment)
+{
+	uint32_t start = segment - stream_buffer;
+	uint32_t position = audio_stream_position();
+
+	completed++;
+
+	if (position >= start && position < start + segment_size)
+	{
+		stats.overlaps++;
+		stats.last_xrun = profile_now();
+	}
+}
+/**
+ * @brief Takes a copy of the counters.
+ *
+ * @param copy Receives the counters
+ */
+void audio_stats_get(audio_stats_t *copy)
+{
+	copy->requests = stats.requests;
+	copy->xruns = stats.xruns;
+	copy->overlaps = stats.overlaps;
+	copy->last_xrun = stats.last_xrun;
+}
+
+/**
+ * @brief Zeroes the counters.
+ */
+void audio_stats_reset(void)
+{
+	stats.requests = 0;
+	stats.xruns = 0;
+	stats.overlaps = 0;
+	stats.last_xrun = 0;
+}
@@ -356,3 +356,48 @@ void board_init(void)
 	LL_FLASH_EnableInstCache();
 	LL_FLASH_EnablePrefetch();
 }
+
+/**
+ * @brief A seed for noise generators and the like, different every power up.
+ * @details Read from the RNG peripheral where the part has one (F7), mixed with the
+ * 96-bit unique ID and the cycle counter.  The F411 has no RNG, so there the ID and
+ * cycle counter are all there is, which still differs between boards and with the
+ * time taken to get here.  Not for cryptography.
+ * @param none
+ * @retval uint32_t The seed
+ */
+uint32_t board_seed(void)
+{
+	const uint32_t *uid = (const uint32_t *)UID_BASE;
+	uint32_t seed = uid[0] ^ (uid[1] * 0x9E3779B9U) ^ (uid[2] * 0x85EBCA6BU) ^ DWT->CYCCNT;
+
+#if defined(RNG)
+	LL_AHB2_GRP1_EnableClock(LL_AHB2_GRP1_PERIPH_RNG);
+	LL_RNG_Enable(RNG);
+
+	/* A few tens of RNG clocks, give up if the clock or seed checks fail */
+	for (uint32_t timeout = 100000; timeout > 0; timeout--)
+	{
+		if (LL_RNG_IsActiveFlag_CECS(RNG) || LL_RNG_IsActiveFlag_SECS(RNG))
+		{
+			break;
+		}
+		if (LL_RNG_IsActiveFlag_DRDY(RNG))
+		{
+			seed ^= LL_RNG_ReadRandData32(RNG);
+			break;
+		}
+	}
+
+	LL_RNG_Disable(RNG);
+	LL_AHB2_GRP1_DisableClock(LL_AHB2_GRP1_PERIPH_RNG);
+#endif
+
+	/* murmur3 finaliser, so similar IDs give unrelated seeds */
+	seed ^= seed >> 16;
+	seed *= 0x85EBCA6BU;
+	seed ^= seed >> 13;
+	seed *= 0xC2B2AE35U;
+	seed ^= seed >> 16;
+	return seed;
+}
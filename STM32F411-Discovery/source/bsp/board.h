@@ -25,10 +25,12 @@
 #include <stm32f4xx_ll_rcc.h>
 #include <stm32f4xx_ll_spi.h>
 #include <stm32f4xx_ll_bus.h>
+#include <stm32f4xx_ll_rng.h>
 #include <stm32f4xx_ll_i2c.h>
 
 #include "pins.h"
 
+uint32_t board_seed(void);
 void i2c_write(uint8_t device_addr, uint8_t addr, uint8_t data);
 
 #endif /* HARDWARE_BOARD_H_ */
@@ -0,0 +1,333 @@
+/**
+ * @file biquad.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Cascades of up to 8 biquad filters, processed a block at a time
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Per sample a section is
+ *
+ *   y  = b0 x + s1
+ *   s1 = b1 x - a1 y + s2
+ *   s2 = b2 x - a2 y
+ *
+ * five multiply-adds.  The outer loop is over the sections and the inner one over the
+ * block, in place, so each section loads its coefficients and state once a block.
+ *
+ * Each sample of a section waits on the one before through s1, so a section on its
+ * own leaves the FPU idle between them.  Mono runs the sections two to a loop, the
+ * second section's work on a sample overlapping the first's on the next, and each
+ * sample is loaded and stored once for the pair.  Stereo runs both channels through
+ * a section in the same loop, for the same reason.
+ */
+#include <math.h>
+#include "biquad.h"
+
+#define PI 3.14159265f
+
+/**
+ * @brief The RBJ cookbook coefficients for a section's parameters.
+ */
+static void design(biquad_section_t *s, float fsr)
+{
+	float f = s->frequency < 0.49f * fsr ? s->frequency : 0.49f * fsr;
+	float w = 2.0f * PI * f / fsr;
+	float cw = cosf(w);
+	float alpha = sinf(w) / (2.0f * s->q);
+	float A = powf(10.0f, s->gain * (1.0f / 40.0f));
+	float shelf = 2.0f * sqrtf(A) * alpha;
+	float b0, b1, b2, a0, a1, a2;
+
+	switch (s->type)
+	{
+	case BIQUAD_LOWPASS:
+		b1 = 1.0f - cw;
+		b0 = b2 = 0.5f * b1;
+		a0 = 1.0f + alpha;
+		a1 = -2.0f * cw;
+		a2 = 1.0f - alpha;
+		break;
+	case BIQUAD_HIGHPASS:
+		b1 = -(1.0f + cw);
+		b0 = b2 = -0.5f * b1;
+		a0 = 1.0f + alpha;
+		a1 = -2.0f * cw;
+		a2 = 1.0f - alpha;
+		break;
+	case BIQUAD_BANDPASS:
+		b0 = alpha;
+		b1 = 0.0f;
+		b2 = -alpha;
+		a0 = 1.0f + alpha;
+		a1 = -2.0f * cw;
+		a2 = 1.0f - alpha;
+		break;
+	case BIQUAD_NOTCH:
+		b0 = b2 = 1.0f;
+		b1 = -2.0f * cw;
+		a0 = 1.0f + alpha;
+		a1 = -2.0f * cw;
+		a2 = 1.0f - alpha;
+		break;
+	case BIQUAD_LOW_SHELF:
+		b0 = A * ((A + 1.0f) - (A - 1.0f) * cw + shelf);
+		b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cw);
+		b2 = A * ((A + 1.0f) - (A - 1.0f) * cw - shelf);
+		a0 = (A + 1.0f) + (A - 1.0f) * cw + shelf;
+		a1 = -2.0f * ((A - 1.0f) + (A + 1.0f) * cw);
+		a2 = (A + 1.0f) + (A - 1.0f) * cw - shelf;
+		break;
+	case BIQUAD_HIGH_SHELF:
+		b0 = A * ((A + 1.0f) + (A - 1.0f) * cw + shelf);
+		b1 = -2.0f * A * ((A - 1.0f) + (A + 1.0f) * cw);
+		b2 = A * ((A + 1.0f) + (A - 1.0f) * cw - shelf);
+		a0 = (A + 1.0f) - (A - 1.0f) * cw + shelf;
+		a1 = 2.0f * ((A - 1.0f) - (A + 1.0f) * cw);
+		a2 = (A + 1.0f) - (A - 1.0f) * cw - shelf;
+		break;
+	default: /* BIQUAD_PEAK */
+		b0 = 1.0f + alpha * A;
+		b1 = -2.0f * cw;
+		b2 = 1.0f - alpha * A;
+		a0 = 1.0f + alpha / A;
+		a1 = -2.0f * cw;
+		a2 = 1.0f - alpha / A;
+		break;
+	}
+
+	a0 = 1.0f / a0;
+	s->b0 = b0 * a0;
+	s->b1 = b1 * a0;
+	s->b2 = b2 * a0;
+	s->a1 = a1 * a0;
+	s->a2 = a2 * a0;
+}
+
+static void mono(const biquad_section_t *c, float *state, float *x, size_t frames)
+{
+	float b0 = c->b0;
+	float b1 = c->b1;
+	float b2 = c->b2;
+	float a1 = c->a1;
+	float a2 = c->a2;
+	float s1 = state[0];
+	float s2 = state[1];
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float in = x[i];
+		float y = b0 * in + s1;
+
+		s1 = b1 * in - a1 * y + s2;
+		s2 = b2 * in - a2 * y;
+		x[i] = y;
+	}
+
+	state[0] = s1;
+	state[1] = s2;
+}
+
+static void mono_pair(const biquad_section_t *c, float *state_a, float *state_b, float *x, size_t frames)
+{
+	float ab0 = c[0].b0;
+	float ab1 = c[0].b1;
+	float ab2 = c[0].b2;
+	float aa1 = c[0].a1;
+	float aa2 = c[0].a2;
+	float bb0 = c[1].b0;
+	float bb1 = c[1].b1;
+	float bb2 = c[1].b2;
+	float ba1 = c[1].a1;
+	float ba2 = c[1].a2;
+	float a1 = state_a[0];
+	float a2 = state_a[1];
+	float b1 = state_b[0];
+	float b2 = state_b[1];
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float in = x[i];
+		float ya = ab0 * in + a1;
+		float yb;
+
+		a1 = ab1 * in - aa1 * ya + a2;
+		a2 = ab2 * in - aa2 * ya;
+		yb = bb0 * ya + b1;
+		b1 = bb1 * ya - ba1 * yb + b2;
+		b2 = bb2 * ya - ba2 * yb;
+		x[i] = yb;
+	}
+
+	state_a[0] = a1;
+	state_a[1] = a2;
+	state_b[0] = b1;
+	state_b[1] = b2;
+}
+
+static void stereo(const biquad_section_t *c, float *state_l, float *state_r, float *l, float *r, size_t frames)
+{
+	float b0 = c->b0;
+	float b1 = c->b1;
+	float b2 = c->b2;
+	float a1 = c->a1;
+	float a2 = c->a2;
+	float l1 = state_l[0];
+	float l2 = state_l[1];
+	float r1 = state_r[0];
+	float r2 = state_r[1];
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float xl = l[i];
+		float xr = r[i];
+		float yl = b0 * xl + l1;
+		float yr = b0 * xr + r1;
+
+		l1 = b1 * xl - a1 * yl + l2;
+		r1 = b1 * xr - a1 * yr + r2;
+		l2 = b2 * xl - a2 * yl;
+		r2 = b2 * xr - a2 * yr;
+		l[i] = yl;
+		r[i] = yr;
+	}
+
+	state_l[0] = l1;
+	state_l[1] = l2;
+	state_r[0] = r1;
+	state_r[1] = r2;
+}
+
+/**
+ * @brief Sets up a cascade, every section passing the signal straight through.
+ *
+ * @param filter The cascade
+ * @param sections 1 to BIQUAD_SECTIONS
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void biquad_init(biquad_t *filter, int sections, float fsr)
+{
+	filter->sections = (uint8_t)(sections < 1 ? 1 : sections > BIQUAD_SECTIONS ? BIQUAD_SECTIONS : sections);
+	filter->fsr = fsr;
+
+	for (int n = 0; n < BIQUAD_SECTIONS; n++)
+	{
+		biquad_section_t *s = &filter->section[n];
+
+		s->type = BIQUAD_PEAK;
+		s->frequency = 0.0f; /* Matches no biquad_set(), so the first always designs */
+		s->q = 0.0f;
+		s->gain = 0.0f;
+		s->b0 = 1.0f;
+		s->b1 = s->b2 = s->a1 = s->a2 = 0.0f;
+	}
+
+	biquad_reset(filter);
+}
+
+/**
+ * @brief Sets a section, only recomputing its coefficients if a parameter changed.
+ *
+ * @param filter The cascade
+ * @param section 0 to sections - 1
+ * @param type The response
+ * @param frequency In Hz, cutoff, centre or shelf midpoint, held below 0.49 fsr
+ * @param q Resonance, 0.707 for Butterworth, also sets the shelf slope (0.707 is
+ * the steepest without a bump)
+ * @param gain In dB, for BIQUAD_LOW_SHELF, BIQUAD_HIGH_SHELF and BIQUAD_PEAK
+ */
+void biquad_set(biquad_t *filter, int section, biquad_type_t type, float frequency, float q, float gain)
+{
+	biquad_section_t *s = &filter->section[section];
+
+	if (s->type == type && s->frequency == frequency && s->q == q && s->gain == gain)
+	{
+		return;
+	}
+
+	s->type = type;
+	s->frequency = frequency;
+	s->q = q;
+	s->gain = gain;
+	design(s, filter->fsr);
+}
+
+/**
+ * @brief Changes the sample rate, recomputing every section set so far.
+ *
+ * @param filter The cascade
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void biquad_set_fsr(biquad_t *filter, float fsr)
+{
+	if (fsr == filter->fsr)
+	{
+		return;
+	}
+
+	filter->fsr = fsr;
+	for (int n = 0; n < BIQUAD_SECTIONS; n++)
+	{
+		if (filter->section[n].frequency > 0.0f)
+		{
+			design(&filter->section[n], fsr);
+		}
+	}
+}
+
+/**
+ * @brief Clears the state, e.g. on a note on or after a dropout.
+ *
+ * @param filter The cascade
+ */
+void biquad_reset(biquad_t *filter)
+{
+	for (int c = 0; c < 2; c++)
+	{
+		for (int n = 0; n < BIQUAD_SECTIONS; n++)
+		{
+			filter->state[c][n][0] = 0.0f;
+			filter->state[c][n][1] = 0.0f;
+		}
+	}
+}
+
+/**
+ * @brief Filters a mono block in place.
+ *
+ * @param filter The cascade
+ * @param buffer Samples to filter
+ * @param frames Number of samples
+ */
+void biquad_process(biquad_t *filter, float *buffer, size_t frames)
+{
+	int n = 0;
+
+	for (; n + 2 <= filter->sections; n += 2)
+	{
+		mono_pair(&filter->section[n], filter->state[0][n], filter->state[0][n + 1], buffer, frames);
+	}
+	if (n < filter->sections)
+	{
+		mono(&filter->section[n], filter->state[0][n], buffer, frames);
+	}
+}
+
+/**
+ * @brief Filters a stereo block in place, both channels through the same sections.
+ *
+ * @param filter The cascade
+ * @param left Left samples to filter
+ * @param right Right samples to filter
+ * @param frames Number of samples
+ */
+void biquad_process_stereo(biquad_t *filter, float *left, float *right, size_t frames)
+{
+	for (int n = 0; n < filter->sections; n++)
+	{
+		stereo(&filter->section[n], filter->state[0][n], filter->state[1][n], left, right, frames);
+	}
+}
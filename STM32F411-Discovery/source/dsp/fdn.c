@@ -0,0 +1,324 @@
+/**
+ * @file fdn.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief 8 line feedback delay network reverb
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Each sample: read the eight lines at their swept lengths, low pass and scale each,
+ * mix them with the Hadamard matrix and write them back with the input added.  For a
+ * decay time T the gain of a line of n samples is 10^(-3 n / (T fsr)), so every line
+ * falls 60 dB in T however long it is, and the 1 / sqrt(8) that makes the Hadamard
+ * matrix orthogonal (lossless) is folded into it.
+ */
+#include <math.h>
+#include <stdbool.h>
+#include "fdn.h"
+#include "sine.h"
+
+/* Line lengths in samples at 48 kHz, all prime (11 to 37 ms and 23 to 79 ms) */
+static const uint16_t compact_lengths[FDN_LINES] = {541, 659, 773, 929, 1097, 1301, 1531, 1789};
+static const uint16_t lush_lengths[FDN_LINES] = {1109, 1327, 1597, 1907, 2269, 2731, 3259, 3803};
+
+/* Input polarity per line, so the lines don't all start in step */
+static const float input_sign[FDN_LINES] = {1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, 1.0f};
+
+static bool is_prime(uint32_t n)
+{
+	if (n < 4)
+	{
+		return n > 1;
+	}
+	if ((n & 1) == 0)
+	{
+		return false;
+	}
+	for (uint32_t k = 3; k * k <= n; k += 2)
+	{
+		if (n % k == 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief The largest prime at or below n not already taken by one of the first lines.
+ */
+static uint32_t prime_length(const fdn_t *fdn, int lines, uint32_t n)
+{
+	for (; n > 2; n--)
+	{
+		bool taken = false;
+
+		for (int k = 0; k < lines; k++)
+		{
+			taken |= fdn->length[k] == (float)n;
+		}
+		if (is_prime(n) && !taken)
+		{
+			break;
+		}
+	}
+	return n;
+}
+
+static void design(fdn_t *fdn)
+{
+	for (int n = 0; n < FDN_LINES; n++)
+	{
+		fdn->gain[n] = powf(10.0f, -3.0f * fdn->length[n] / (fdn->decay * fdn->fsr)) * 0.35355339f;
+	}
+}
+
+/**
+ * @brief In place 8 point Hadamard transform, unscaled.
+ */
+static inline void hadamard(float *x)
+{
+	for (int span = 1; span < FDN_LINES; span *= 2)
+	{
+		for (int i = 0; i < FDN_LINES; i += 2 * span)
+		{
+			for (int j = i; j < i + span; j++)
+			{
+				float a = x[j];
+				float b = x[j + span];
+
+				x[j] = a + b;
+				x[j + span] = a - b;
+			}
+		}
+	}
+}
+
+static inline void run(fdn_t *fdn, float *left, float *right, size_t frames, const bool compact)
+{
+	delay_t line[FDN_LINES];
+	delay_q15_t line_q15[FDN_LINES];
+	float length[FDN_LINES];
+	float gain[FDN_LINES];
+	float lowpass[FDN_LINES];
+	float pole = fdn->pole;
+	float wet = fdn->wet * 0.5f;
+	float depth = fdn->depth;
+	float phase = fdn->phase;
+	float rate = fdn->rate;
+
+	for (int n = 0; n < FDN_LINES; n++)
+	{
+		if (compact)
+		{
+			line_q15[n] = fdn->line_q15[n];
+		}
+		else
+		{
+			line[n] = fdn->line[n];
+		}
+		length[n] = fdn->length[n];
+		gain[n] = fdn->gain[n];
+		lowpass[n] = fdn->lowpass[n];
+	}
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float in = 0.5f * (left[i] + right[i]);
+		float s = depth * sine_poly(phase);
+		float c = depth * sine_poly(phase < 0.75f ? phase + 0.25f : phase - 0.75f);
+		float sweep[4] = {s, c, -s, -c};
+		float x[FDN_LINES];
+
+		for (int n = 0; n < FDN_LINES; n++)
+		{
+			x[n] = compact ? delay_q15_read_linear(&line_q15[n], length[n] + sweep[n & 3])
+										 : delay_read_lagrange(&line[n], length[n] + sweep[n & 3]);
+		}
+
+		left[i] += wet * (x[0] + x[2] + x[4] + x[6]);
+		right[i] += wet * (x[1] + x[3] + x[5] + x[7]);
+
+		for (int n = 0; n < FDN_LINES; n++)
+		{
+			lowpass[n] = x[n] + pole * (lowpass[n] - x[n]);
+			x[n] = gain[n] * lowpass[n];
+		}
+
+		hadamard(x);
+
+		for (int n = 0; n < FDN_LINES; n++)
+		{
+			if (compact)
+			{
+				delay_q15_write(&line_q15[n], x[n] + input_sign[n] * in);
+			}
+			else
+			{
+				delay_write(&line[n], x[n] + input_sign[n] * in);
+			}
+		}
+
+		phase += rate;
+		phase -= phase >= 1.0f ? 1.0f : 0.0f;
+	}
+
+	for (int n = 0; n < FDN_LINES; n++)
+	{
+		if (compact)
+		{
+			fdn->line_q15[n].write = line_q15[n].write;
+		}
+		else
+		{
+			fdn->line[n].write = line[n].write;
+		}
+		fdn->lowpass[n] = lowpass[n];
+	}
+	fdn->phase = phase;
+}
+
+/**
+ * @brief Sets up a reverb and clears its lines, 2 s decay, 6 kHz damping, wet 0.3.
+ *
+ * @param fdn The reverb
+ * @param profile FDN_COMPACT or FDN_LUSH
+ * @param ram The lines, declared with DELAY_RAM, FDN_COMPACT_RAM or FDN_LUSH_RAM bytes
+ * @param bytes Size of ram
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void fdn_init(fdn_t *fdn, fdn_profile_t profile, void *ram, size_t bytes, float fsr)
+{
+	const bool compact = profile == FDN_COMPACT;
+	const uint16_t *lengths = compact ? compact_lengths : lush_lengths;
+	uint32_t size;
+
+	fdn->profile = profile;
+	fdn->fsr = fsr;
+	fdn->depth = compact ? 6.0f : 12.0f;
+	fdn->phase = 0.0f;
+	fdn->rate = (compact ? 0.5f : 0.3f) / fsr;
+
+	/* The first line rounds the share down to a power of two, the rest follow it */
+	if (compact)
+	{
+		delay_q15_init(&fdn->line_q15[0], ram, (uint32_t)(bytes / (FDN_LINES * sizeof(int16_t))));
+		size = fdn->line_q15[0].mask + 1;
+	}
+	else
+	{
+		delay_init(&fdn->line[0], ram, (uint32_t)(bytes / (FDN_LINES * sizeof(float))));
+		size = fdn->line[0].mask + 1;
+	}
+
+	for (int n = 0; n < FDN_LINES; n++)
+	{
+		/* Scaled to fsr and moved down to a prime, so the lines stay mutually prime */
+		uint32_t room = (uint32_t)fdn->depth + 3; /* For the sweep and the read taps */
+		uint32_t longest = size > room + 2 ? size - room : 2;
+		uint32_t length = (uint32_t)(lengths[n] * (fsr / 48000.0f));
+
+		if (compact)
+		{
+			delay_q15_init(&fdn->line_q15[n], (int16_t *)ram + n * size, size);
+		}
+		else
+		{
+			delay_init(&fdn->line[n], (float *)ram + n * size, size);
+		}
+		fdn->length[n] = (float)prime_length(fdn, n, length < longest ? length : longest);
+		fdn->lowpass[n] = 0.0f;
+	}
+
+	fdn->decay = 2.0f;
+	fdn->damping = -1.0f; /* So the set below designs */
+	design(fdn);
+	fdn_set_damping(fdn, 6000.0f);
+	fdn_set_wet(fdn, 0.3f);
+}
+
+/**
+ * @brief Sets the decay time, only recomputing on a change.
+ *
+ * @param fdn The reverb
+ * @param decay Seconds to fall 60 dB at low frequencies, 0.1 to 30
+ */
+void fdn_set_decay(fdn_t *fdn, float decay)
+{
+	decay = decay < 0.1f ? 0.1f : decay > 30.0f ? 30.0f : decay;
+	if (decay != fdn->decay)
+	{
+		fdn->decay = decay;
+		design(fdn);
+	}
+}
+
+/**
+ * @brief Sets the damping, only recomputing on a change.
+ *
+ * @param fdn The reverb
+ * @param damping Cutoff in Hz of the low pass in each line, lower for a darker tail
+ */
+void fdn_set_damping(fdn_t *fdn, float damping)
+{
+	if (damping != fdn->damping)
+	{
+		fdn->damping = damping;
+		fdn->pole = expf(-6.28318531f * damping / fdn->fsr);
+	}
+}
+
+/**
+ * @brief Sets the level of the reverb added to the block.
+ *
+ * @param fdn The reverb
+ * @param wet 0 to 1
+ */
+void fdn_set_wet(fdn_t *fdn, float wet)
+{
+	fdn->wet = wet;
+}
+
+/**
+ * @brief Silences the tail.
+ *
+ * @param fdn The reverb
+ */
+void fdn_clear(fdn_t *fdn)
+{
+	for (int n = 0; n < FDN_LINES; n++)
+	{
+		if (fdn->profile == FDN_COMPACT)
+		{
+			delay_q15_clear(&fdn->line_q15[n]);
+		}
+		else
+		{
+			delay_clear(&fdn->line[n]);
+		}
+		fdn->lowpass[n] = 0.0f;
+	}
+}
+
+/**
+ * @brief Adds the reverb of a stereo block to it, in place.
+ *
+ * @param fdn The reverb
+ * @param left Left samples
+ * @param right Right samples
+ * @param frames Number of samples
+ */
+void fdn_process(fdn_t *fdn, float *left, float *right, size_t frames)
+{
+	if (fdn->profile == FDN_COMPACT)
+	{
+		run(fdn, left, right, frames, true);
+	}
+	else
+	{
+		run(fdn, left, right, frames, false);
+	}
+}
@@ -0,0 +1,77 @@
+/**
+ * @file fdn.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief 8 line feedback delay network reverb
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Eight delay lines (see delay.h) of mutually prime lengths feed back into each other
+ * through an 8 x 8 Hadamard matrix, worked out as three stages of sums and
+ * differences (24 adds, no multiplies).  Each line has a one-pole low pass in its
+ * feedback for the damping, the high end dying away faster than the low, and a gain
+ * giving the same decay time whatever its length.  The read positions are swept a
+ * few samples by a slow quadrature LFO, in four phases across the lines, to break up
+ * the metallic ringing of fixed delays.
+ *
+ * The input is the mono sum of the block, the left output the even lines and the
+ * right the odd, added to the block in place at the wet level.  Two profiles:
+ *
+ *   FDN_COMPACT  Q15 lines of DELAY_SIZE(11), 11 to 37 ms, linear reads,
+ *                FDN_COMPACT_RAM (32K), for the F411 alongside a polysynth
+ *   FDN_LUSH     float lines of DELAY_SIZE(12), 23 to 79 ms, Lagrange reads and a
+ *                deeper sweep, FDN_LUSH_RAM (128K), for the F767
+ *
+ * The RAM is the caller's, declared with DELAY_RAM, and split between the lines.
+ * The lengths are primes at 48 kHz, scaled to fsr and moved down to a prime there,
+ * so above 48 kHz they are held to what the lines hold.
+ */
+#ifndef DSP_FDN_H_
+#define DSP_FDN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "delay.h"
+
+#define FDN_LINES 8
+#define FDN_COMPACT_BITS 11
+#define FDN_LUSH_BITS 12
+#define FDN_COMPACT_RAM (FDN_LINES * DELAY_SIZE(FDN_COMPACT_BITS) * sizeof(int16_t))
+#define FDN_LUSH_RAM (FDN_LINES * DELAY_SIZE(FDN_LUSH_BITS) * sizeof(float))
+
+typedef enum
+{
+	FDN_COMPACT,
+	FDN_LUSH
+} fdn_profile_t;
+
+typedef struct
+{
+	fdn_profile_t profile;
+	delay_t line[FDN_LINES]; /* FDN_LUSH */
+	delay_q15_t line_q15[FDN_LINES]; /* FDN_COMPACT */
+	float length[FDN_LINES]; /* Samples, before the sweep */
+	float gain[FDN_LINES]; /* Decay per trip round the line, with the matrix scale */
+	float lowpass[FDN_LINES]; /* Damping filter states */
+	float fsr;
+	float decay; /* Seconds to -60 dB */
+	float damping; /* Hz */
+	float pole; /* Damping filter coefficient */
+	float wet;
+	float depth; /* Sweep in samples */
+	float phase; /* LFO, 0 to 1 */
+	float rate; /* LFO increment per sample */
+} fdn_t;
+
+void fdn_init(fdn_t *fdn, fdn_profile_t profile, void *ram, size_t bytes, float fsr);
+void fdn_set_decay(fdn_t *fdn, float decay);
+void fdn_set_damping(fdn_t *fdn, float damping);
+void fdn_set_wet(fdn_t *fdn, float wet);
+void fdn_clear(fdn_t *fdn);
+
+void fdn_process(fdn_t *fdn, float *left, float *right, size_t frames);
+
+#endif /* DSP_FDN_H_ */
@@ -0,0 +1,63 @@
+/**
+ * @file noise.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief White, pink and LFSR noise generators
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Three types:
+ *
+ *   NOISE_WHITE      xorshift32, four independent generators side by side so four
+ *                    samples come out of each pass with no dependency between them.
+ *   NOISE_PINK       Voss-McCartney, 16 rows of white noise each updated half as
+ *                    often as the one before, summed.  Close to -3 dB per octave
+ *                    from a few Hz up to fsr / 4.
+ *   NOISE_LFSR       15-bit LFSR as in the NES/Game Boy noise channels, stepped at
+ *   NOISE_LFSR_SHORT noise_set_rate() and output as a square -1/+1.  The short mode
+ *                    taps bit 6 rather than bit 1 for a metallic 93-step loop.
+ *
+ * Every generator is integer, a Q31 block is the cheapest output, the float blocks
+ * scale that.  The seed is best taken from board_seed(), which reads the RNG
+ * peripheral where there is one, so every power up sounds different.  Equal seeds
+ * give equal noise.
+ */
+#ifndef DSP_NOISE_H_
+#define DSP_NOISE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NOISE_PINK_ROWS 16
+
+typedef enum
+{
+	NOISE_WHITE,
+	NOISE_PINK,
+	NOISE_LFSR,
+	NOISE_LFSR_SHORT
+} noise_type_t;
+
+typedef struct
+{
+	noise_type_t type;
+	uint32_t state[4]; /* xorshift32 generators, never 0 */
+	uint32_t counter;	 /* Pink, picks the row to update */
+	int32_t rows[NOISE_PINK_ROWS];
+	int32_t sum; /* Of the rows */
+	uint32_t lfsr;
+	uint32_t phase; /* LFSR clock, a cycle is 2^32 */
+	uint32_t inc;
+} noise_t;
+
+void noise_init(noise_t *noise, noise_type_t type, uint32_t seed);
+void noise_set_rate(noise_t *noise, float frequency, float fsr);
+
+void noise_render(noise_t *noise, float *out, size_t frames);
+void noise_mix(noise_t *noise, float *out, size_t frames, float gain);
+void noise_render_q31(noise_t *noise, int32_t *out, size_t frames);
+
+#endif /* DSP_NOISE_H_ */
@@ -0,0 +1,106 @@
+/**
+ * @file phasor.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Fixed-point phase-accumulator oscillators with Q31 and Q15 outputs
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The phase is a uint32_t, a whole cycle is 2^32, so it wraps for free on overflow and
+ * never drifts: the increment (phasor_increment()) is worked out once from the
+ * frequency and pConfig->fsr and added as an integer.  The phase resolves fsr / 2^32,
+ * about 11 uHz at 48 kHz, and the increment, worked out in float, is good to 1 part
+ * in 2^24 (0.0001 cent).
+ *
+ * The saw, square and triangle come straight from the phase bits, with no branches,
+ * and are not band-limited (see osc_blep.h for that).  They suit LFOs, sub
+ * oscillators and fixed-point patches.  The sine reads sine_table_1024 (see sine.h)
+ * with the top 10 phase bits as the index.
+ *
+ * Output is Q31 (int32_t) or Q15 (int16_t) blocks for audio_convert_mono_q31() and
+ * friends, or one sample at a time with phasor_next() and the phasor_q31_...()
+ * functions, for renderers that write frames directly (see main.c).
+ */
+#ifndef DSP_PHASOR_H_
+#define DSP_PHASOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sine.h"
+
+typedef enum
+{
+	PHASOR_SAW,
+	PHASOR_SQUARE,
+	PHASOR_TRIANGLE,
+	PHASOR_SINE
+} phasor_shape_t;
+
+typedef struct
+{
+	phasor_shape_t shape;
+	uint32_t phase; /* A cycle is 2^32 */
+	uint32_t inc;
+} phasor_t;
+
+/**
+ * @brief The current phase, then steps on by one sample.
+ */
+static inline uint32_t phasor_next(phasor_t *p)
+{
+	uint32_t phase = p->phase;
+
+	p->phase = phase + p->inc;
+	return phase;
+}
+
+/**
+ * @brief Rising saw, -1 at phase 0.
+ */
+static inline int32_t phasor_q31_saw(uint32_t phase)
+{
+	return (int32_t)(phase ^ 0x80000000U);
+}
+
+/**
+ * @brief Square, +1 for the first half cycle.
+ */
+static inline int32_t phasor_q31_square(uint32_t phase)
+{
+	return ((int32_t)phase >> 31) ^ INT32_MAX;
+}
+
+/**
+ * @brief Triangle, -1 at phase 0 and +1 at half a cycle.
+ */
+static inline int32_t phasor_q31_triangle(uint32_t phase)
+{
+	uint32_t folded = phase ^ (uint32_t)((int32_t)phase >> 31);
+
+	return (int32_t)((folded << 1) ^ 0x80000000U);
+}
+
+/**
+ * @brief Sine, from sine_table_1024 with the low 22 phase bits interpolating.
+ */
+static inline int32_t phasor_q31_sine(uint32_t phase)
+{
+	uint32_t index = phase >> 22;
+	float frac = (float)(phase & 0x3FFFFFU) * (1.0f / 4194304.0f);
+	float a = sine_table_1024[index];
+	float y = a + frac * (sine_table_1024[index + 1] - a);
+
+	return (int32_t)(y * 2147483520.0f); /* Largest float below 2^31, so 1.0 can't overflow */
+}
+
+uint32_t phasor_increment(float frequency, float fsr);
+void phasor_init(phasor_t *p, phasor_shape_t shape, float frequency, float fsr);
+void phasor_set_frequency(phasor_t *p, float frequency, float fsr);
+
+void phasor_render_q31(phasor_t *p, int32_t *out, size_t frames);
+void phasor_render_q15(phasor_t *p, int16_t *out, size_t frames);
+
+#endif /* DSP_PHASOR_H_ */
@@ -0,0 +1,100 @@
+/**
+ * @file ramp.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Sample-accurate parameter ramps, linear and one-pole
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * A parameter set once a block steps every SAMPLE_BLOCK_SIZE samples, which is heard
+ * as zipper noise when it is modulated.  A ramp moves it to a new target a sample at
+ * a time instead:
+ *
+ *   RAMP_LINEAR    in a straight line, reaching the target after the ramp time.
+ *   RAMP_ONE_POLE  exponentially, the ramp time being the time constant, as an
+ *                  analogue glide.  Taken as reached after 9.2 time constants
+ *                  (within 1 / 10000 of the jump).
+ *
+ * Both are value = value * scale + offset per sample, one multiply-add, scale being 1
+ * for the linear ramp.  A ramp knows how many samples it has left and snaps to the
+ * target at the end, so it never creeps.  Once there it is settled, and a generator
+ * goes back to its loop with the parameter constant:
+ *
+ *   size_t n = ramp_span(&r, frames);   samples of this block still ramping
+ *   ... n samples, stepping the value with ramp_step() ...
+ *   ramp_advance(&r, n, value);
+ *   ... frames - n samples, with r.value constant ...
+ *
+ * ramp_render() and ramp_apply() do the same for a block of values or a gain.
+ */
+#ifndef DSP_RAMP_H_
+#define DSP_RAMP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+	RAMP_LINEAR,
+	RAMP_ONE_POLE
+} ramp_type_t;
+
+typedef struct
+{
+	ramp_type_t type;
+	float value;
+	float target;
+	float scale; /* value = value * scale + offset per sample */
+	float offset;
+	float decay; /* One-pole, scale for the ramp time */
+	uint32_t length; /* Samples to reach a target, 0 jumps straight to it */
+	uint32_t remaining; /* Samples left, 0 once settled */
+} ramp_t;
+
+/**
+ * @brief True once the value has reached the target.
+ */
+static inline bool ramp_settled(const ramp_t *r)
+{
+	return r->remaining == 0;
+}
+
+/**
+ * @brief Samples of a block of frames still ramping, the rest are at the target.
+ */
+static inline size_t ramp_span(const ramp_t *r, size_t frames)
+{
+	return r->remaining < frames ? r->remaining : frames;
+}
+
+/**
+ * @brief The value one sample on, keep it in a local across the loop.
+ */
+static inline float ramp_step(const ramp_t *r, float value)
+{
+	return value * r->scale + r->offset;
+}
+
+/**
+ * @brief Stores the value after n samples of ramp_step(), snapping to the target
+ * if the ramp has finished.
+ */
+static inline void ramp_advance(ramp_t *r, size_t n, float value)
+{
+	r->remaining -= (uint32_t)n;
+	r->value = r->remaining ? value : r->target;
+}
+
+void ramp_init(ramp_t *r, ramp_type_t type, float value, float seconds, float fsr);
+void ramp_set_time(ramp_t *r, float seconds, float fsr);
+void ramp_set_target(ramp_t *r, float target);
+void ramp_jump(ramp_t *r, float value);
+
+void ramp_render(ramp_t *r, float *out, size_t frames);
+void ramp_apply(ramp_t *r, float *buffer, size_t frames);
+
+#endif /* DSP_RAMP_H_ */
@@ -0,0 +1,215 @@
+/**
+ * @file unison.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Supersaw, a stack of detuned band-limited saws spread across the stereo field
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The phases, increments and gains are copied to locals for the block, and the saw
+ * count is a constant at each call of run() for the usual 5, 7 and 9, so the loop
+ * over the saws unrolls and each sample is the saws' phase adds, PolyBLEP checks and
+ * two multiply-adds each into L and R, with one store of each.
+ *
+ * Saw v of n is detuned by (2v / (n - 1) - 1) x detune x UNISON_DETUNE_CENTS and
+ * panned by the same amount x spread, alternate saws to alternate sides, with
+ * constant power pan gains.
+ */
+#include <math.h>
+#include <stdbool.h>
+#include "osc_blep.h"
+#include "unison.h"
+
+#define PI 3.14159265f
+
+static inline void run(unison_t *osc, float *left, float *right, size_t frames, float gain, bool mix, int voices)
+{
+	float t[UNISON_MAX];
+	float dt[UNISON_MAX];
+	float rdt[UNISON_MAX];
+	float gl[UNISON_MAX];
+	float gr[UNISON_MAX];
+
+	for (int v = 0; v < voices; v++)
+	{
+		t[v] = osc->phase[v];
+		dt[v] = osc->inc[v];
+		rdt[v] = osc->rinc[v];
+		gl[v] = gain * osc->left[v];
+		gr[v] = gain * osc->right[v];
+	}
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float l = mix ? left[i] : 0.0f;
+		float r = mix ? right[i] : 0.0f;
+
+		for (int v = 0; v < voices; v++)
+		{
+			float y = 2.0f * t[v] - 1.0f - osc_polyblep(t[v], dt[v], rdt[v]);
+
+			l += gl[v] * y;
+			r += gr[v] * y;
+			t[v] += dt[v];
+			t[v] = t[v] >= 1.0f ? t[v] - 1.0f : t[v];
+		}
+
+		left[i] = l;
+		right[i] = r;
+	}
+
+	for (int v = 0; v < voices; v++)
+	{
+		osc->phase[v] = t[v];
+	}
+}
+
+static void render(unison_t *osc, float *left, float *right, size_t frames, float gain, bool mix)
+{
+	switch (osc->voices)
+	{
+	case 5:
+		run(osc, left, right, frames, gain, mix, 5);
+		break;
+	case 7:
+		run(osc, left, right, frames, gain, mix, 7);
+		break;
+	case 9:
+		run(osc, left, right, frames, gain, mix, 9);
+		break;
+	default:
+		run(osc, left, right, frames, gain, mix, osc->voices);
+		break;
+	}
+}
+
+/**
+ * @brief Where saw v sits in the stack, -1 to 1.
+ */
+static inline float position(const unison_t *osc, int v)
+{
+	return osc->voices > 1 ? 2.0f * v / (osc->voices - 1) - 1.0f : 0.0f;
+}
+
+static void tune(unison_t *osc)
+{
+	for (int v = 0; v < osc->voices; v++)
+	{
+		float cents = position(osc, v) * osc->detune * UNISON_DETUNE_CENTS;
+		float inc = osc->frequency * powf(2.0f, cents * (1.0f / 1200.0f)) / osc->fsr;
+
+		osc->inc[v] = inc;
+		osc->rinc[v] = 1.0f / inc;
+	}
+}
+
+static void pan(unison_t *osc)
+{
+	float level = 1.0f / sqrtf((float)osc->voices);
+
+	for (int v = 0; v < osc->voices; v++)
+	{
+		/* -1 left to 1 right, alternate saws to alternate sides, counted in from both
+		   ends so each saw and its mirror (v, voices - 1 - v) land on opposite sides */
+		int from_end = v < osc->voices - 1 - v ? v : osc->voices - 1 - v;
+		float p = position(osc, v) * osc->spread * (from_end & 1 ? -1.0f : 1.0f);
+		float angle = (p + 1.0f) * (PI / 4.0f);
+
+		osc->left[v] = level * cosf(angle);
+		osc->right[v] = level * sinf(angle);
+	}
+}
+
+/**
+ * @brief Sets up a stack, with a detune of 0.5 and full spread.
+ *
+ * @param osc The oscillator
+ * @param voices Saws, 1 to UNISON_MAX
+ * @param frequency In Hz, the centre saw
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void unison_init(unison_t *osc, int voices, float frequency, float fsr)
+{
+	osc->voices = (uint8_t)(voices < 1 ? 1 : voices > UNISON_MAX ? UNISON_MAX : voices);
+	osc->frequency = frequency;
+	osc->fsr = fsr;
+	osc->detune = 0.5f;
+	osc->spread = 1.0f;
+
+	/* Golden ratio steps, well spread for any count */
+	for (int v = 0; v < osc->voices; v++)
+	{
+		float t = v * 0.61803399f;
+
+		osc->phase[v] = t - (int)t;
+	}
+
+	tune(osc);
+	pan(osc);
+}
+
+/**
+ * @brief Changes the frequency, the phases carry on.
+ *
+ * @param osc The oscillator
+ * @param frequency In Hz, the centre saw
+ */
+void unison_set_frequency(unison_t *osc, float frequency)
+{
+	osc->frequency = frequency;
+	tune(osc);
+}
+
+/**
+ * @brief Sets the detune.
+ *
+ * @param osc The oscillator
+ * @param detune 0 to 1, the outer saws UNISON_DETUNE_CENTS out at 1
+ */
+void unison_set_detune(unison_t *osc, float detune)
+{
+	osc->detune = detune;
+	tune(osc);
+}
+
+/**
+ * @brief Sets the stereo spread.
+ *
+ * @param osc The oscillator
+ * @param spread 0 (mono) to 1 (outer saws hard left and right)
+ */
+void unison_set_spread(unison_t *osc, float spread)
+{
+	osc->spread = spread;
+	pan(osc);
+}
+
+/**
+ * @brief Renders a block of stereo samples.
+ *
+ * @param osc The oscillator
+ * @param left Receives the left samples
+ * @param right Receives the right samples
+ * @param frames Number of samples
+ */
+void unison_render(unison_t *osc, float *left, float *right, size_t frames)
+{
+	render(osc, left, right, frames, 1.0f, false);
+}
+
+/**
+ * @brief Adds a block of stereo samples to left and right.
+ *
+ * @param osc The oscillator
+ * @param left Left samples to add to
+ * @param right Right samples to add to
+ * @param frames Number of samples
+ * @param gain Applied before adding
+ */
+void unison_mix(unison_t *osc, float *left, float *right, size_t frames, float gain)
+{
+	render(osc, left, right, frames, gain, true);
+}
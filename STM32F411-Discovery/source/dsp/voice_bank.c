@@ -0,0 +1,224 @@
+/**
+ * @file voice_bank.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Polyphonic bank of fixed-point oscillators in struct-of-arrays layout
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The outer loop is over pairs of voices and the inner one over the block, so the
+ * pair's phases, increments and amplitudes stay in registers and each sample is the
+ * two phase adds, two waves, a PKHBT and an SMLAD.  The shape is a constant at each
+ * call of run(), as in phasor.c.
+ *
+ * The sine is the Q15 table (sine_table_q15) with the top 10 phase bits as the index
+ * and the next 15 interpolating, all integer so there is no float in the loop.
+ */
+#include "voice_bank.h"
+
+#if defined(__ARM_FEATURE_DSP)
+
+#include "cmsis_compiler.h"
+
+#define PAIR(a, b) __PKHBT((a), (b), 16)
+#define SMLAD(x, y, acc) ((int32_t)__SMLAD((x), (y), (uint32_t)(acc)))
+#define SAT_Q31(x) __QADD((x), (x))
+
+#else
+
+#define PAIR(a, b) (((uint32_t)(a) & 0xFFFFU) | ((uint32_t)(b) << 16))
+#define SMLAD(x, y, acc) smlad((x), (y), (acc))
+#define SAT_Q31(x) sat_q31(x)
+
+static inline int32_t smlad(uint32_t x, uint32_t y, int32_t acc)
+{
+	return acc + (int16_t)x * (int16_t)y + (int16_t)(x >> 16) * (int16_t)(y >> 16);
+}
+
+static inline int32_t sat_q31(int32_t x)
+{
+	int64_t y = (int64_t)x * 2;
+
+	return y > INT32_MAX ? INT32_MAX : y < INT32_MIN ? INT32_MIN : (int32_t)y;
+}
+
+#endif
+
+static inline int32_t sine_q15(uint32_t phase)
+{
+	uint32_t index = phase >> 22;
+	int32_t frac = (int32_t)((phase >> 7) & 0x7FFFU);
+	int32_t a = sine_table_q15[index];
+
+	return a + (((sine_table_q15[index + 1] - a) * frac) >> 15);
+}
+
+static inline int32_t shape_q15(phasor_shape_t shape, uint32_t phase)
+{
+	switch (shape)
+	{
+	case PHASOR_SAW:
+		return phasor_q31_saw(phase) >> 16;
+	case PHASOR_SQUARE:
+		return phasor_q31_square(phase) >> 16;
+	case PHASOR_TRIANGLE:
+		return phasor_q31_triangle(phase) >> 16;
+	default:
+		return sine_q15(phase);
+	}
+}
+
+static inline void run(voice_bank_t *bank, phasor_shape_t shape, int32_t *bus, size_t frames)
+{
+	const uint32_t *amps = (const uint32_t *)bank->amp;
+
+	for (int v = 0; v < bank->count; v += 2)
+	{
+		uint32_t phase0 = bank->phase[v];
+		uint32_t phase1 = bank->phase[v + 1];
+		uint32_t inc0 = bank->inc[v];
+		uint32_t inc1 = bank->inc[v + 1];
+		uint32_t amp = amps[v / 2];
+
+		for (size_t i = 0; i < frames; i++)
+		{
+			uint32_t pair = PAIR(shape_q15(shape, phase0), shape_q15(shape, phase1));
+
+			bus[i] = SMLAD(pair, amp, bus[i]);
+			phase0 += inc0;
+			phase1 += inc1;
+		}
+		bank->phase[v] = phase0;
+		bank->phase[v + 1] = phase1;
+	}
+}
+
+static int16_t amp_q15(float amp)
+{
+	return (int16_t)(amp >= 1.0f ? INT16_MAX : amp <= -1.0f ? -INT16_MAX : amp * 32767.0f);
+}
+
+/**
+ * @brief Sets up an empty bank.
+ *
+ * @param bank The bank
+ * @param shape PHASOR_SAW, PHASOR_SQUARE, PHASOR_TRIANGLE or PHASOR_SINE
+ */
+void voice_bank_init(voice_bank_t *bank, phasor_shape_t shape)
+{
+	bank->shape = shape;
+	bank->count = 0;
+	for (int v = 0; v < VOICE_BANK_MAX; v++)
+	{
+		bank->phase[v] = 0;
+		bank->inc[v] = 0;
+		bank->amp[v] = 0;
+	}
+}
+
+/**
+ * @brief Starts a voice, at phase 0.
+ *
+ * @param bank The bank
+ * @param frequency In Hz, below fsr / 2
+ * @param amp -1.0 to 1.0
+ * @param fsr The sample rate (pConfig->fsr)
+ * @return int The voice, or -1 if the bank is full
+ */
+int voice_bank_start(voice_bank_t *bank, float frequency, float amp, float fsr)
+{
+	int voice = bank->count;
+
+	if (voice == VOICE_BANK_MAX)
+	{
+		return -1;
+	}
+
+	bank->count++;
+	bank->phase[voice] = 0;
+	voice_bank_set(bank, voice, frequency, amp, fsr);
+	return voice;
+}
+
+/**
+ * @brief Stops a voice, the last voice (count - 1) moves into its slot.
+ *
+ * @param bank The bank
+ * @param voice The voice from voice_bank_start()
+ */
+void voice_bank_stop(voice_bank_t *bank, int voice)
+{
+	int last = bank->count - 1;
+
+	if (voice < 0 || voice > last)
+	{
+		return;
+	}
+
+	bank->phase[voice] = bank->phase[last];
+	bank->inc[voice] = bank->inc[last];
+	bank->amp[voice] = bank->amp[last];
+
+	/* The slot after the active voices pads an odd count, so must be silent */
+	bank->amp[last] = 0;
+	bank->count--;
+}
+
+/**
+ * @brief Changes a voice's frequency and amplitude, the phase carries on.
+ *
+ * @param bank The bank
+ * @param voice The voice from voice_bank_start()
+ * @param frequency In Hz, below fsr / 2
+ * @param amp -1.0 to 1.0
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void voice_bank_set(voice_bank_t *bank, int voice, float frequency, float amp, float fsr)
+{
+	bank->inc[voice] = phasor_increment(frequency, fsr);
+	bank->amp[voice] = amp_q15(amp);
+}
+
+/**
+ * @brief Adds a block of every active voice to the bus.
+ *
+ * @param bank The bank
+ * @param bus Q30 samples, added to (clear it first)
+ * @param frames Number of samples
+ */
+void voice_bank_render(voice_bank_t *bank, int32_t *bus, size_t frames)
+{
+	switch (bank->shape)
+	{
+	case PHASOR_SAW:
+		run(bank, PHASOR_SAW, bus, frames);
+		break;
+	case PHASOR_SQUARE:
+		run(bank, PHASOR_SQUARE, bus, frames);
+		break;
+	case PHASOR_TRIANGLE:
+		run(bank, PHASOR_TRIANGLE, bus, frames);
+		break;
+	case PHASOR_SINE:
+		run(bank, PHASOR_SINE, bus, frames);
+		break;
+	}
+}
+
+/**
+ * @brief Q30 bus to Q31 samples, saturating, can be done in place.
+ *
+ * @param bus Q30 samples from voice_bank_render()
+ * @param out Receives the Q31 samples
+ * @param frames Number of samples
+ */
+void voice_bank_to_q31(const int32_t *bus, int32_t *out, size_t frames)
+{
+	for (size_t i = 0; i < frames; i++)
+	{
+		out[i] = SAT_Q31(bus[i]);
+	}
+}
@@ -0,0 +1,57 @@
+/**
+ * @file voice_bank.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Polyphonic bank of fixed-point oscillators in struct-of-arrays layout
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Holds the phase, increment and amplitude of up to VOICE_BANK_MAX voices in three
+ * arrays, rather than an array of oscillators, so a block of every active voice is
+ * rendered by one loop.  The voices share a shape (see phasor.h), each one has its own
+ * frequency and a Q15 amplitude.
+ *
+ * Voices are taken two at a time: the two Q15 samples are packed into a word and
+ * multiplied by the packed amplitudes and added to the bus with one SMLAD on
+ * Cortex-M4/M7, so a pair costs one bus load and store.  An odd voice is paired with
+ * a silent one, a stopped voice's slot is filled by the last voice, so the active
+ * voices are always 0 to count - 1.
+ *
+ * The bus is Q30, so it has headroom for a sum up to 2.0.  Keep the amplitudes of the
+ * voices that sound together to 1.0 or less and voice_bank_to_q31() gives full scale
+ * Q31 for audio_convert_mono_q31() and friends, saturating anything over.
+ *
+ * Voices per MHz is the figure to watch: 1 / (fsr x cycles per voice-sample), in
+ * MHz, where the cycles are from the profiler (see main.c) over block x voices.
+ */
+#ifndef DSP_VOICE_BANK_H_
+#define DSP_VOICE_BANK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "phasor.h"
+
+/* Must be even, an odd count is padded with the next (silent) slot */
+#define VOICE_BANK_MAX 32
+
+typedef struct
+{
+	phasor_shape_t shape;
+	uint8_t count; /* Active voices, 0 to count - 1 */
+	uint32_t phase[VOICE_BANK_MAX];
+	uint32_t inc[VOICE_BANK_MAX];
+	int16_t amp[VOICE_BANK_MAX] __attribute__((aligned(4))); /* Q15, read in pairs */
+} voice_bank_t;
+
+void voice_bank_init(voice_bank_t *bank, phasor_shape_t shape);
+int voice_bank_start(voice_bank_t *bank, float frequency, float amp, float fsr);
+void voice_bank_stop(voice_bank_t *bank, int voice);
+void voice_bank_set(voice_bank_t *bank, int voice, float frequency, float amp, float fsr);
+
+void voice_bank_render(voice_bank_t *bank, int32_t *bus, size_t frames);
+void voice_bank_to_q31(const int32_t *bus, int32_t *out, size_t frames);
+
+#endif /* DSP_VOICE_BANK_H_ */
@@ -0,0 +1,60 @@
+/**
+ * @file wavetable.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Mipmapped wavetable oscillator with frame morphing
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The tables are generated at build time by tools/wavetable_gen.c and end up in flash
+ * as const data.  There are WAVETABLE_FRAMES waveforms (see the generator for the
+ * list) and each is held at WAVETABLE_LEVELS band limits, one per octave.  Level 0
+ * has WAVETABLE_SIZE / 2 harmonics, each level after it half as many.  The oscillator
+ * picks the level with as many harmonics as fit below Nyquist at its frequency, so it
+ * never aliases however many harmonics the waveform has.
+ *
+ * Each table is padded with one sample before and two after (wrapped round) so the
+ * cubic interpolation never has to wrap its index.
+ *
+ * The morph position moves between neighbouring frames, 0 is frame 0 and
+ * WAVETABLE_FRAMES - 1 the last.  Frequency, morph and interpolation are picked up
+ * once per block.
+ */
+#ifndef DSP_WAVETABLE_H_
+#define DSP_WAVETABLE_H_
+
+#include <stddef.h>
+
+#define WAVETABLE_SIZE 256									/* Samples per cycle */
+#define WAVETABLE_STRIDE (WAVETABLE_SIZE + 3) /* Plus the guard samples */
+#define WAVETABLE_LEVELS 8										/* 128 harmonics down to 1 */
+#define WAVETABLE_FRAMES 8
+
+/* Generated, see tools/wavetable_gen.c */
+extern const float wavetable_bank[WAVETABLE_FRAMES][WAVETABLE_LEVELS][WAVETABLE_STRIDE];
+
+typedef enum
+{
+	WAVETABLE_LINEAR,
+	WAVETABLE_CUBIC
+} wavetable_interp_t;
+
+typedef struct
+{
+	wavetable_interp_t interp;
+	float phase; /* 0 to 1 */
+	float inc;	 /* Cycles per sample, frequency / fsr */
+	float morph; /* 0 to WAVETABLE_FRAMES - 1 */
+} wavetable_osc_t;
+
+void wavetable_init(wavetable_osc_t *osc, wavetable_interp_t interp, float frequency, float fsr);
+void wavetable_set_frequency(wavetable_osc_t *osc, float frequency, float fsr);
+void wavetable_set_morph(wavetable_osc_t *osc, float morph);
+
+void wavetable_render(wavetable_osc_t *osc, float *out, size_t frames);
+void wavetable_mix(wavetable_osc_t *osc, float *out, size_t frames, float gain);
+
+#endif /* DSP_WAVETABLE_H_ */
@@ -0,0 +1,300 @@
+/**
+ * @file audio_host.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host stand-in for audio.c, simulates the I2S/DMA stream (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * A timer thread plays the part of the I2S peripheral and DMA stream.  Once every block
+ * period (block / fsr) it raises the half/complete transfer flag and calls the DMA IRQ
+ * handler in main.c, exactly as the hardware would.  With more than two segments only
+ * TC is raised, as in double-buffer mode.  The super-loop in main() is left to pick up
+ * the refill, so the render code runs unmodified.  If the handler pends PendSV
+ * (RENDER_CALLBACK) it is taken next, from the timer thread.
+ *
+ * Each segment is copied to a WAV file as the stream moves on to it, so a refill that
+ * is late is heard as stale audio just as it would be on the DAC.  The read position is
+ * worked out from the time into the current segment, for the xrun checks in
+ * audio_stats.c.
+ *
+ * Render time is measured by the profiler sections in main.c (see profile.h) and
+ * reported against the block deadline when the run completes.
+ *
+ * The run is controlled from the environment:
+ *
+ *   AUDIO_HOST_SECONDS  Seconds of audio to stream (default 5)
+ *   AUDIO_HOST_WAV      Output WAV file (default audio.wav)
+ *   AUDIO_HOST_CSV      Optional file to receive the refill time (section 0) of every block
+ *   AUDIO_HOST_BLOCK    Overrides the block size passed to audio_streaming_start()
+ *   AUDIO_HOST_SEGMENTS Overrides the number of ring segments
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "audio.h"
+#include "board.h"
+#include "host_clock.h"
+#include "profile.h"
+#include "wav.h"
+
+#define NS_PER_SEC 1000000000LL
+
+DMA_TypeDef host_dma1;
+SCB_Type host_scb;
+
+/*
+ * Same LUT as bsp/audio.c, only .bits and .fsr matter to the host.
+ */
+audio_config_t configs[] =
+{
+	{.N = 271, .R = 2, .DIV = 6, .ODD = 0, .MCKOE = 1, .bits = 16, .type = I2S_44_MCKOE_16, .fsr = 44108.0f},
+	{.N = 258, .R = 3, .DIV = 3, .ODD = 1, .MCKOE = 1, .bits = 16, .type = I2S_48_MCKOE_16, .fsr = 47991.0f},
+	{.N = 271, .R = 2, .DIV = 6, .ODD = 0, .MCKOE = 1, .bits = 32, .type = I2S_44_MCKOE_32, .fsr = 44108.0f},
+	{.N = 258, .R = 3, .DIV = 3, .ODD = 1, .MCKOE = 1, .bits = 32, .type = I2S_48_MCKOE_32, .fsr = 47991.0f}
+};
+
+static uint32_t block_count;
+
+static audio_config_t *config;
+static int16_t *dma_buffer;
+static int64_t period;
+
+/* The segment being sent and when it started, and the one just finished */
+static volatile int sending;
+static volatile int64_t sending_since;
+static volatile int finished;
+static int32_t frames[SAMPLE_BLOCK_MAX * 2];
+static wav_t wav;
+static FILE *csv;
+
+/**
+ * @brief Copies one transmitted buffer segment to the WAV file.
+ * @details 32-bit frames are stored as two halfwords, MSB first, exactly as the SPI
+ * data register wants them.  These are put back together for the file.
+ *
+ * @param segment The segment of the DMA buffer that is being sent
+ */
+static void capture(const int16_t *segment)
+{
+	if (config->bits == 16)
+	{
+		wav_write(&wav, segment, config->block);
+		return;
+	}
+
+	for (int i = 0; i < config->block * 2; i++)
+	{
+		frames[i] = (int32_t)(((uint32_t)(uint16_t)segment[2 * i] << 16) | (uint16_t)segment[2 * i + 1]);
+	}
+	wav_write(&wav, frames, config->block);
+}
+
+/**
+ * @brief Where the simulated DMA is reading from.
+ *
+ * @return uint32_t Halfword offset into the audio buffer
+ */
+uint32_t audio_stream_position(void)
+{
+	int64_t elapsed = host_now_ns() - sending_since;
+	uint32_t sent = elapsed >= period ? config->segment - 1U : (uint32_t)(config->segment * elapsed / period);
+
+	return sending * config->segment + sent;
+}
+
+/**
+ * @brief The segment just sent, called from the DMA IRQ handler.
+ *
+ * @param complete Unused, the stream thread knows which segment it finished
+ * @return int16_t* The segment to refill
+ */
+int16_t *audio_segment_done(bool complete)
+{
+	(void)complete;
+
+	return dma_buffer + finished * config->segment;
+}
+
+/**
+ * @brief Logs the refill time of the blocks completed since the last call.
+ * @details A sample is only logged when exactly one refill has completed, otherwise
+ * the refill has fallen behind (or not started) and the time can't be attributed.
+ *
+ * @param block The block that is about to be requested
+ */
+static void log_refill(uint32_t block)
+{
+	static uint32_t last_count;
+	static uint64_t last_total;
+	profile_section_t *s = &profile_sections[0];
+	uint32_t count = s->count;
+	uint64_t total = s->total;
+
+	if (count - last_count == 1)
+	{
+		fprintf(csv, "%u,%llu\n", block, (unsigned long long)(total - last_total));
+	}
+	last_count = count;
+	last_total = total;
+}
+
+/**
+ * @brief Prints the profiler sections and xrun counts.
+ */
+static void report(void)
+{
+	audio_stats_t stats;
+
+	printf("%u blocks of %u frames x %u segments at %.2f Hz, deadline %.2f us\n",
+				 block_count, config->block, config->segments, config->fsr, 1e6 * config->block / config->fsr);
+	profile_print();
+
+	audio_stats_get(&stats);
+	printf("%u refills requested, %u xruns, %u overlaps\n", stats.requests, stats.xruns, stats.overlaps);
+
+	if (csv != NULL)
+	{
+		fclose(csv);
+	}
+}
+
+/**
+ * @brief Moves the stream on to a ring segment, which is "heard" from now on.
+ *
+ * @param segment Index of the segment
+ */
+static void send(int segment)
+{
+	sending = segment;
+	sending_since = host_now_ns();
+	capture(dma_buffer + segment * config->segment);
+}
+
+/**
+ * @brief The simulated DMA stream, one loop per ring segment.
+ */
+static void *dma_stream(void *arg)
+{
+	int64_t next = host_now_ns();
+
+	(void)arg;
+
+	send(0);
+
+	for (uint32_t block = 0; block < block_count; block++)
+	{
+		struct timespec ts;
+		int segment = block % config->segments;
+
+		next += period;
+		ts.tv_sec = next / NS_PER_SEC;
+		ts.tv_nsec = next % NS_PER_SEC;
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+		if (csv != NULL)
+		{
+			log_refill(block);
+		}
+
+		/* On to the next segment */
+		finished = segment;
+		send((segment + 1) % config->segments);
+
+		/* Raise HT after the first half of a double buffer, otherwise TC, and take the interrupt */
+		I2S_DMA->HISR |= config->segments == 2 && segment == 0 ? HOST_DMA_FLAG_HT : HOST_DMA_FLAG_TC;
+		HOST_DMA_IRQHandler();
+		I2S_DMA->HISR &= ~I2S_DMA->HIFCR;
+		I2S_DMA->HIFCR = 0;
+
+		/* Then the lower priority PendSV, if the handler asked for it */
+		if (SCB->ICSR & SCB_ICSR_PENDSVSET_Msk)
+		{
+			SCB->ICSR &= ~SCB_ICSR_PENDSVSET_Msk;
+			PendSV_Handler();
+		}
+	}
+
+	/* Let the last refill land in the timings */
+	struct timespec settle = {.tv_sec = 0, .tv_nsec = period};
+	nanosleep(&settle, NULL);
+
+	wav_close(&wav);
+	report();
+	exit(EXIT_SUCCESS);
+
+	return NULL;
+}
+
+/**
+ * @brief Starts the simulated I2S audio stream, SAMPLE_BLOCK_SIZE frames in two halves.
+ *
+ * @param audio_buffer The audio buffer (AUDIO_BUF_MAX)
+ * @param audio_mode The audio mode (only the sample rate and bits are used)
+ * @return audio_config_t*  The config from LUT (the caller needs this)
+ */
+audio_config_t *audio_streaming_run(int16_t audio_buffer[], audio_mode_t audio_mode)
+{
+	return audio_streaming_start(audio_buffer, audio_mode, SAMPLE_BLOCK_SIZE, 2);
+}
+
+/**
+ * @brief Starts the simulated I2S audio stream with a given latency.
+ * @details block and segments are clamped as in bsp/audio.c.
+ *
+ * @param audio_buffer The audio buffer (AUDIO_BUF_MAX)
+ * @param audio_mode The audio mode (only the sample rate and bits are used)
+ * @param block Frames per refill, 16, 32, 64, 128 or 256
+ * @param segments Segments in the ring, at least 2
+ * @return audio_config_t*  The config from LUT (the caller needs this)
+ */
+audio_config_t *audio_streaming_start(int16_t audio_buffer[], audio_mode_t audio_mode, uint16_t block, uint8_t segments)
+{
+	const char *seconds = getenv("AUDIO_HOST_SECONDS");
+	const char *wav_path = getenv("AUDIO_HOST_WAV");
+	const char *csv_path = getenv("AUDIO_HOST_CSV");
+	const char *block_env = getenv("AUDIO_HOST_BLOCK");
+	const char *segments_env = getenv("AUDIO_HOST_SEGMENTS");
+	pthread_t thread;
+
+	block = block_env ? (uint16_t)atoi(block_env) : block;
+	segments = segments_env ? (uint8_t)atoi(segments_env) : segments;
+
+	config = &configs[audio_mode];
+
+	/* Fit the ring into the static buffer, for this many bits */
+	audio_layout(config, block, segments);
+	block = config->block;
+
+	dma_buffer = audio_buffer;
+	period = (int64_t)(NS_PER_SEC * block / config->fsr);
+
+	/* Start counting xruns afresh */
+	audio_stats_init(audio_buffer, config);
+
+	block_count = (uint32_t)((seconds ? atof(seconds) : 5.0) * config->fsr / block);
+
+	if (!wav_open(&wav, wav_path ? wav_path : "audio.wav", (uint32_t)(config->fsr + 0.5f), 2, config->bits))
+	{
+		fprintf(stderr, "Unable to create %s\n", wav_path ? wav_path : "audio.wav");
+		exit(EXIT_FAILURE);
+	}
+
+	csv = csv_path ? fopen(csv_path, "w") : NULL;
+	if (csv != NULL)
+	{
+		fprintf(csv, "block,refill_ns\n");
+	}
+
+	if (pthread_create(&thread, NULL, dma_stream, NULL) != 0)
+	{
+		fprintf(stderr, "Unable to start the DMA stream thread\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return config;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file filter_bench.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host benchmark of the filters (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Times a block of SAMPLE_BLOCK_SIZE samples through biquad cascades (dsp/biquad.c)
+ * of 1, 2, 4 and 8 sections, mono and stereo, and prints the time per sample per
+ * section (per channel for stereo).  Then the cost of biquad_set() with the
+ * parameters unchanged, the cached case, against a new frequency every call.  The
+ * state variable filter (dsp/svf.c) and ladder (dsp/ladder.c) are timed at a set
+ * cutoff and with a cutoff per sample, against a biquad redesigned every sample, the
+ * way a swept filter would be without them.
+ * These are host figures, for the target put the filter in a profiler section (see
+ * main.c) and divide its mean cycles by the block size.
+ *
+ *   STM32F411-Discovery-host-filter-bench [iterations]
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "audio.h"
+#include "biquad.h"
+#include "host_clock.h"
+#include "ladder.h"
+#include "svf.h"
+
+#define FRAMES SAMPLE_BLOCK_SIZE
+#define FSR 48000.0f
+
+static float left[FRAMES];
+static float right[FRAMES];
+static float cutoff[FRAMES];
+
+static void noise(float *out, size_t frames)
+{
+	for (size_t i = 0; i < frames; i++)
+	{
+		out[i] = (float)rand() / RAND_MAX - 0.5f;
+	}
+}
+
+static double time_biquad_ns(int sections, bool stereo, long iterations)
+{
+	static biquad_t filter;
+	double start;
+
+	biquad_init(&filter, sections, FSR);
+	for (int n = 0; n < sections; n++)
+	{
+		biquad_set(&filter, n, BIQUAD_PEAK, 100.0f * (n + 1), 1.0f, -3.0f);
+	}
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (stereo)
+		{
+			biquad_process_stereo(&filter, left, right, FRAMES);
+		}
+		else
+		{
+			biquad_process(&filter, left, FRAMES);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES * sections * (stereo ? 2 : 1));
+}
+
+static double time_set_ns(bool changing, long iterations)
+{
+	static biquad_t filter;
+	double start;
+
+	biquad_init(&filter, 1, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		float frequency = changing ? 1000.0f + (i & 1023) : 1000.0f;
+
+		biquad_set(&filter, 0, BIQUAD_LOWPASS, frequency, 0.707f, 0.0f);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / iterations;
+}
+
+static double time_svf_ns(bool modulated, long iterations)
+{
+	svf_t filter;
+	double start;
+
+	svf_init(&filter, SVF_LOWPASS, 1000.0f, 2.0f, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (modulated)
+		{
+			svf_process_mod(&filter, left, cutoff, FRAMES);
+		}
+		else
+		{
+			svf_process(&filter, left, FRAMES);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_ladder_ns(bool modulated, long iterations)
+{
+	ladder_t filter;
+	double start;
+
+	ladder_init(&filter, 1000.0f, 0.7f, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (modulated)
+		{
+			ladder_process_mod(&filter, left, cutoff, FRAMES);
+		}
+		else
+		{
+			ladder_process(&filter, left, FRAMES);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+/**
+ * @brief A biquad low pass redesigned and run a sample at a time.
+ */
+static double time_biquad_swept_ns(long iterations)
+{
+	static biquad_t filter;
+	double start;
+
+	biquad_init(&filter, 1, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		for (int n = 0; n < FRAMES; n++)
+		{
+			biquad_set(&filter, 0, BIQUAD_LOWPASS, cutoff[n], 2.0f, 0.0f);
+			biquad_process(&filter, &left[n], 1);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+int main(int argc, char *argv[])
+{
+	long iterations = argc > 1 ? atol(argv[1]) : 20000;
+
+	noise(left, FRAMES);
+	noise(right, FRAMES);
+	for (int i = 0; i < FRAMES; i++)
+	{
+		cutoff[i] = 500.0f + 20.0f * i;
+	}
+
+	printf("%u samples per block\n", FRAMES);
+	printf("%-18s %13s %13s\n", "biquad", "mono", "stereo");
+	printf("%-18s %13s %13s\n", "sections", "ns/sample/s", "ns/sample/s");
+
+	for (int sections = 1; sections <= BIQUAD_SECTIONS; sections *= 2)
+	{
+		printf("%-18d %13.3f %13.3f\n", sections, time_biquad_ns(sections, false, iterations),
+					 time_biquad_ns(sections, true, iterations));
+	}
+
+	printf("\n%-18s %13s\n", "biquad_set()", "ns/call");
+	printf("%-18s %13.3f\n", "unchanged", time_set_ns(false, iterations * 10));
+	printf("%-18s %13.3f\n", "new frequency", time_set_ns(true, iterations * 10));
+
+	printf("\n%-18s %13s %13s\n", "cutoff", "set", "per sample");
+	printf("%-18s %13.3f %13.3f\n", "svf", time_svf_ns(false, iterations), time_svf_ns(true, iterations));
+	printf("%-18s %13.3f %13.3f\n", "ladder", time_ladder_ns(false, iterations), time_ladder_ns(true, iterations));
+	printf("%-18s %13s %13.3f\n", "biquad redesigned", "", time_biquad_swept_ns(iterations / 10));
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file filter_response.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host check of the ZDF filters against their analogue prototypes (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Runs an impulse through each mode of dsp/svf.c and the ladder in dsp/ladder.c at a
+ * few cutoffs and resonances, and takes the magnitude of the response at 6 points an
+ * octave from 20 Hz to 20 kHz.  The TPT filters are the bilinear transform of their
+ * analogue prototypes with the cutoff prewarped, so the response at f should be the
+ * prototype's at tan(pi f / fsr) / tan(pi fc / fsr), worked out here in double with
+ * the library tan().  Points where the prototype is below -60 dB (the stop bands and
+ * notches) are skipped, float rounding dominates there.
+ *
+ * Then svf_process_mod() and ladder_process_mod() with every sample at the set cutoff
+ * are compared with svf_process() and ladder_process(), and each is swept over 6
+ * octaves by a 1 kHz sine at full resonance to check it stays bounded.
+ *
+ * Prints the worst error in dB for each and exits with EXIT_FAILURE if any is over
+ * TOLERANCE_DB, or a modulated run is off or unbounded.
+ *
+ *   STM32F411-Discovery-host-filter-response
+ */
+#include <complex.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ladder.h"
+#include "svf.h"
+
+#define N 65536
+#define FSR 48000.0f
+#define TOLERANCE_DB 0.01
+#define FLOOR_DB -60.0
+
+typedef double complex (*prototype_t)(double complex s, double k);
+
+static float impulse[N];
+static float reference[N];
+
+static double complex lowpass(double complex s, double k)
+{
+	return 1.0 / (s * s + k * s + 1.0);
+}
+
+static double complex bandpass(double complex s, double k)
+{
+	return k * s / (s * s + k * s + 1.0);
+}
+
+static double complex highpass(double complex s, double k)
+{
+	return s * s / (s * s + k * s + 1.0);
+}
+
+static double complex notch(double complex s, double k)
+{
+	return (s * s + 1.0) / (s * s + k * s + 1.0);
+}
+
+static double complex peak(double complex s, double k)
+{
+	return (1.0 - s * s) / (s * s + k * s + 1.0);
+}
+
+static double complex allpass(double complex s, double k)
+{
+	return (s * s - k * s + 1.0) / (s * s + k * s + 1.0);
+}
+
+static double complex ladder(double complex s, double k)
+{
+	return (1.0 + k) / (cpow(1.0 + s, 4) + k);
+}
+
+static void clear(float *x)
+{
+	for (int i = 0; i < N; i++)
+	{
+		x[i] = 0.0f;
+	}
+	x[0] = 1.0f;
+}
+
+/**
+ * @brief The worst difference in dB between the impulse response and the prototype.
+ */
+static double compare(const float *response, prototype_t prototype, double k, double cutoff)
+{
+	double worst = 0.0;
+	double warp = tan(M_PI * cutoff / FSR);
+
+	for (double f = 20.0; f <= 20000.0; f *= pow(2.0, 1.0 / 6.0))
+	{
+		double complex sum = 0.0;
+		double complex step = cexp(-I * 2.0 * M_PI * f / FSR);
+		double complex z = 1.0;
+		double expected = 20.0 * log10(cabs(prototype(I * tan(M_PI * f / FSR) / warp, k)));
+
+		if (expected < FLOOR_DB)
+		{
+			continue;
+		}
+
+		for (int i = 0; i < N; i++)
+		{
+			sum += response[i] * z;
+			z *= step;
+		}
+
+		double error = fabs(20.0 * log10(cabs(sum)) - expected);
+
+		worst = error > worst ? error : worst;
+	}
+	return worst;
+}
+
+static double difference(const float *a, const float *b)
+{
+	double worst = 0.0;
+
+	for (int i = 0; i < N; i++)
+	{
+		double d = fabs((double)a[i] - b[i]);
+
+		worst = d > worst ? d : worst;
+	}
+	return worst;
+}
+
+static double largest(const float *x)
+{
+	double worst = 0.0;
+
+	for (int i = 0; i < N; i++)
+	{
+		worst = fabs(x[i]) > worst ? fabs(x[i]) : worst;
+	}
+	return worst;
+}
+
+/**
+ * @brief A cutoff at each sample, constant or swept by a sine over 6 octaves.
+ */
+static void cutoffs(float *out, float cutoff, bool sweep)
+{
+	for (int i = 0; i < N; i++)
+	{
+		out[i] = sweep ? 50.0f * powf(2.0f, 3.0f + 3.0f * sinf(2.0f * (float)M_PI * 1000.0f * i / FSR)) : cutoff;
+	}
+}
+
+static bool report(const char *name, double error, double mod, double bound)
+{
+	bool pass = error <= TOLERANCE_DB && mod < 1e-5 && bound < 100.0;
+
+	printf("%-28s %10.5f %12.2e %10.2f  %s\n", name, error, mod, bound, pass ? "ok" : "FAIL");
+	return pass;
+}
+
+int main(void)
+{
+	static const struct
+	{
+		const char *name;
+		svf_mode_t mode;
+		prototype_t prototype;
+	} modes[] = {
+			{"lowpass", SVF_LOWPASS, lowpass},
+			{"bandpass", SVF_BANDPASS, bandpass},
+			{"highpass", SVF_HIGHPASS, highpass},
+			{"notch", SVF_NOTCH, notch},
+			{"peak", SVF_PEAK, peak},
+			{"allpass", SVF_ALLPASS, allpass},
+	};
+	static const float svf_cutoffs[] = {100.0f, 1000.0f, 10000.0f};
+	static const float svf_q[] = {0.707f, 4.0f};
+	static const float ladder_cutoffs[] = {100.0f, 1000.0f, 8000.0f};
+	static const float resonances[] = {0.0f, 0.5f, 0.9f};
+	static float buffer[N];
+	static float cutoff[N];
+	bool pass = true;
+	char name[64];
+
+	printf("%-28s %10s %12s %10s\n", "filter", "error dB", "mod error", "swept peak");
+
+	for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+	{
+		for (size_t c = 0; c < sizeof(svf_cutoffs) / sizeof(svf_cutoffs[0]); c++)
+		{
+			for (size_t q = 0; q < sizeof(svf_q) / sizeof(svf_q[0]); q++)
+			{
+				svf_t svf;
+				double error, mod, bound;
+
+				svf_init(&svf, modes[m].mode, svf_cutoffs[c], svf_q[q], FSR);
+				clear(reference);
+				svf_process(&svf, reference, N);
+				error = compare(reference, modes[m].prototype, 1.0 / svf_q[q], svf_cutoffs[c]);
+
+				svf_reset(&svf);
+				clear(impulse);
+				cutoffs(cutoff, svf_cutoffs[c], false);
+				svf_process_mod(&svf, impulse, cutoff, N);
+				mod = difference(impulse, reference);
+
+				svf_reset(&svf);
+				for (int i = 0; i < N; i++)
+				{
+					buffer[i] = (i & 64) ? 0.5f : -0.5f;
+				}
+				cutoffs(cutoff, 0.0f, true);
+				svf_set_q(&svf, 20.0f);
+				svf_process_mod(&svf, buffer, cutoff, N);
+				bound = largest(buffer);
+
+				snprintf(name, sizeof(name), "svf %s %.0f Hz Q %.3g", modes[m].name, svf_cutoffs[c], svf_q[q]);
+				pass &= report(name, error, mod, bound);
+			}
+		}
+	}
+
+	for (size_t c = 0; c < sizeof(ladder_cutoffs) / sizeof(ladder_cutoffs[0]); c++)
+	{
+		for (size_t r = 0; r < sizeof(resonances) / sizeof(resonances[0]); r++)
+		{
+			ladder_t filter;
+			double error, mod, bound;
+
+			ladder_init(&filter, ladder_cutoffs[c], resonances[r], FSR);
+			clear(reference);
+			ladder_process(&filter, reference, N);
+			error = compare(reference, ladder, 4.0 * resonances[r], ladder_cutoffs[c]);
+
+			ladder_reset(&filter);
+			clear(impulse);
+			cutoffs(cutoff, ladder_cutoffs[c], false);
+			ladder_process_mod(&filter, impulse, cutoff, N);
+			mod = difference(impulse, reference);
+
+			ladder_reset(&filter);
+			for (int i = 0; i < N; i++)
+			{
+				buffer[i] = (i & 64) ? 0.5f : -0.5f;
+			}
+			cutoffs(cutoff, 0.0f, true);
+			ladder_set_resonance(&filter, 1.0f);
+			ladder_process_mod(&filter, buffer, cutoff, N);
+			bound = largest(buffer);
+
+			snprintf(name, sizeof(name), "ladder %.0f Hz resonance %.1f", ladder_cutoffs[c], resonances[r]);
+			pass &= report(name, error, mod, bound);
+		}
+	}
+
+	printf("%s\n", pass ? "all within tolerance" : "FAILED");
+	return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
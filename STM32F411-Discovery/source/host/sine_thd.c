@@ -0,0 +1,220 @@
+/**
+ * @file sine_thd.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host measurement of the THD and SNR of each sine backend (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Renders 65536 samples of each backend in dsp/sine.c, and of the parabolic
+ * approximation main.c used before it, and takes a Blackman-Harris windowed FFT.
+ * The test frequencies are a whole number of cycles in the FFT, so the float phase
+ * accumulator is exact and the table and polynomial errors show up as they would on
+ * the target.
+ *
+ *   THD  power in harmonics 2 to 10 (aliased or not), relative to the fundamental
+ *   SNR  fundamental against everything else except DC and those harmonics
+ *
+ * A table's interpolation error repeats every table step, so most of it lands on
+ * high harmonics which alias, and is counted as noise.
+ *
+ * Results are in dB, lower THD and higher SNR are better.  The rotator's amplitude
+ * correction is once per SAMPLE_BLOCK_SIZE as it would be in the render loop.
+ *
+ *   STM32F411-Discovery-host-sine-thd
+ */
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "audio.h"
+#include "sine.h"
+
+#define N 65536
+#define FSR 48000.0f
+#define HALF_WIDTH 8 /* Bins either side of a harmonic, the window's main lobe is 4 */
+#define HARMONICS 10
+
+static float samples[N];
+static double complex spectrum[N];
+static double power[N / 2];
+
+static void fft(double complex *x, int n)
+{
+	for (int i = 1, j = 0; i < n; i++)
+	{
+		int bit = n >> 1;
+
+		for (; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j ^= bit;
+
+		if (i < j)
+		{
+			double complex t = x[i];
+			x[i] = x[j];
+			x[j] = t;
+		}
+	}
+
+	for (int len = 2; len <= n; len <<= 1)
+	{
+		double complex w = cexp(-2.0 * I * M_PI / len);
+
+		for (int i = 0; i < n; i += len)
+		{
+			double complex wk = 1.0;
+
+			for (int k = 0; k < len / 2; k++)
+			{
+				double complex a = x[i + k];
+				double complex b = x[i + k + len / 2] * wk;
+
+				x[i + k] = a + b;
+				x[i + k + len / 2] = a - b;
+				wk *= w;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Parabolic approximation from the original main.c, for comparison.
+ */
+static void parabolic(float *out, size_t frames, float inc)
+{
+	const float PI = 3.1415926535897932384626433832795f;
+	const float B = 4.0f / PI;
+	const float C = -4.0f / (PI * PI);
+	const float P = 0.225f;
+	float acc = 0.5f;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		if (acc > 1.0f)
+		{
+			acc -= 1.0f;
+		}
+
+		float angle = -1.0f * (acc * 2.0f * PI - PI);
+		float y = B * angle + C * angle * fabsf(angle);
+
+		out[i] = (P * (y * fabsf(y) - y) + y);
+		acc += inc;
+	}
+}
+
+static void render(int backend, int cycles)
+{
+	float frequency = cycles * FSR / N;
+
+	if (backend < 0)
+	{
+		parabolic(samples, N, frequency / FSR);
+		return;
+	}
+
+	sine_osc_t osc;
+
+	sine_init(&osc, (sine_backend_t)backend, frequency, FSR);
+	for (int i = 0; i < N; i += SAMPLE_BLOCK_SIZE)
+	{
+		sine_render(&osc, samples + i, SAMPLE_BLOCK_SIZE);
+	}
+}
+
+/**
+ * @brief THD and SNR of the samples, the fundamental is at bin cycles.
+ */
+static void measure(int cycles, double *thd, double *snr)
+{
+	double fundamental = 0.0, harmonics = 0.0, noise = 0.0;
+
+	for (int i = 0; i < N; i++)
+	{
+		double t = 2.0 * M_PI * i / N;
+		double window = 0.35875 - 0.48829 * cos(t) + 0.14128 * cos(2.0 * t) - 0.01168 * cos(3.0 * t);
+
+		spectrum[i] = samples[i] * window;
+	}
+	fft(spectrum, N);
+
+	for (int k = 0; k < N / 2; k++)
+	{
+		power[k] = creal(spectrum[k]) * creal(spectrum[k]) + cimag(spectrum[k]) * cimag(spectrum[k]);
+	}
+
+	/* Bins of each harmonic, aliased ones fold back below Nyquist */
+	static signed char harmonic[N / 2];
+
+	for (int k = 0; k < N / 2; k++)
+	{
+		harmonic[k] = k <= HALF_WIDTH ? -1 : 0;
+	}
+	for (int h = HARMONICS; h >= 1; h--)
+	{
+		int bin = (int)(((long)h * cycles) % N);
+
+		bin = bin > N / 2 ? N - bin : bin;
+		for (int k = bin - HALF_WIDTH; k <= bin + HALF_WIDTH; k++)
+		{
+			if (k > HALF_WIDTH && k < N / 2)
+			{
+				harmonic[k] = (signed char)h;
+			}
+		}
+	}
+
+	for (int k = 0; k < N / 2; k++)
+	{
+		if (harmonic[k] == 1)
+		{
+			fundamental += power[k];
+		}
+		else if (harmonic[k] > 1)
+		{
+			harmonics += power[k];
+		}
+		else if (harmonic[k] == 0)
+		{
+			noise += power[k];
+		}
+	}
+
+	*thd = 10.0 * log10(harmonics / fundamental);
+	*snr = 10.0 * log10(fundamental / noise);
+}
+
+int main(void)
+{
+	static const char *names[] = {"parabolic (old)", "table 256", "table 1024", "polynomial", "rotator"};
+	static const int tests[] = {601, 7001}; /* Cycles in N, about 440 Hz and 5.1 kHz */
+
+	printf("%-16s", "backend");
+	for (size_t t = 0; t < sizeof(tests) / sizeof(tests[0]); t++)
+	{
+		printf("   THD @%6.0f Hz   SNR", tests[t] * FSR / N);
+	}
+	printf("\n");
+
+	for (int backend = -1; backend <= SINE_ROTATOR; backend++)
+	{
+		printf("%-16s", names[backend + 1]);
+		for (size_t t = 0; t < sizeof(tests) / sizeof(tests[0]); t++)
+		{
+			double thd, snr;
+
+			render(backend, tests[t]);
+			measure(tests[t], &thd, &snr);
+			printf("   %17.1f %6.1f", thd, snr);
+		}
+		printf("\n");
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file wav.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Minimal PCM WAV file writer (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Writes a canonical 44 byte RIFF header followed by little-endian interleaved PCM.
+ * The sizes in the header are patched when the file is closed.
+ */
+#include <string.h>
+#include "wav.h"
+
+static void put_u16(uint8_t *p, uint16_t v)
+{
+	p[0] = v & 0xFF;
+	p[1] = v >> 8;
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+	put_u16(p, v & 0xFFFF);
+	put_u16(p + 2, v >> 16);
+}
+
+static void write_header(wav_t *wav, uint32_t fsr)
+{
+	uint8_t h[44];
+	uint16_t block_align = wav->channels * (wav->bits / 8);
+
+	memcpy(h, "RIFF", 4);
+	put_u32(h + 4, 36 + wav->data_bytes);
+	memcpy(h + 8, "WAVEfmt ", 8);
+	put_u32(h + 16, 16);					/* fmt chunk size */
+	put_u16(h + 20, 1);						/* PCM */
+	put_u16(h + 22, wav->channels);
+	put_u32(h + 24, fsr);
+	put_u32(h + 28, fsr * block_align); /* byte rate */
+	put_u16(h + 32, block_align);
+	put_u16(h + 34, wav->bits);
+	memcpy(h + 36, "data", 4);
+	put_u32(h + 40, wav->data_bytes);
+
+	fwrite(h, sizeof(h), 1, wav->file);
+}
+
+/**
+ * @brief Creates a WAV file and writes a provisional header.
+ *
+ * @param wav The writer state
+ * @param path Output file name
+ * @param fsr Sample rate in Hz
+ * @param channels Interleaved channel count
+ * @param bits 16 or 32 bit signed PCM
+ * @return true if the file was created
+ */
+bool wav_open(wav_t *wav, const char *path, uint32_t fsr, uint16_t channels, uint16_t bits)
+{
+	wav->file = fopen(path, "wb");
+	wav->channels = channels;
+	wav->bits = bits;
+	wav->data_bytes = 0;
+
+	if (wav->file == NULL)
+	{
+		return false;
+	}
+
+	write_header(wav, fsr);
+	return true;
+}
+
+/**
+ * @brief Appends interleaved frames, samples must already be host (little) endian.
+ *
+ * @param wav The writer state
+ * @param samples int16_t or int32_t samples to match the bits passed to wav_open()
+ * @param frames The number of frames (samples per channel)
+ */
+void wav_write(wav_t *wav, const void *samples, uint32_t frames)
+{
+	uint32_t bytes = frames * wav->channels * (wav->bits / 8);
+
+	fwrite(samples, bytes, 1, wav->file);
+	wav->data_bytes += bytes;
+}
+
+/**
+ * @brief Patches the header sizes and closes the file.
+ *
+ * @param wav The writer state
+ */
+void wav_close(wav_t *wav)
+{
+	uint8_t size[4];
+
+	if (wav->file == NULL)
+	{
+		return;
+	}
+
+	put_u32(size, 36 + wav->data_bytes);
+	fseek(wav->file, 4, SEEK_SET);
+	fwrite(size, sizeof(size), 1, wav->file);
+
+	put_u32(size, wav->data_bytes);
+	fseek(wav->file, 40, SEEK_SET);
+	fwrite(size, sizeof(size), 1, wav->file);
+
+	fclose(wav->file);
+	wav->file = NULL;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file wav.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Minimal PCM WAV file writer (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef HOST_WAV_H_
+#define HOST_WAV_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct
+{
+	FILE *file;
+	uint16_t channels;
+	uint16_t bits;
+	uint32_t data_bytes;
+} wav_t;
+
+bool wav_open(wav_t *wav, const char *path, uint32_t fsr, uint16_t channels, uint16_t bits);
+void wav_write(wav_t *wav, const void *samples, uint32_t frames);
+void wav_close(wav_t *wav);
+
+#endif /* HOST_WAV_H_ */
@@ -8,114 +8,549 @@
  * @copyright Copyright (c) 2023
  *
  */
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+#include "additive.h"
 #include "audio.h"
+#include "audio_convert.h"
+#include "biquad.h"
 #include "board.h"
+#include "delay.h"
+#include "fdn.h"
+#include "fm.h"
+#include "ladder.h"
+#include "noise.h"
+#include "osc_blep.h"
+#include "phasor.h"
+#include "plate.h"
+#include "profile.h"
+#include "ramp.h"
+#include "sine.h"
+#include "unison.h"
+#include "voice_bank.h"
+#include "wavetable.h"
 
-static int16_t audio_buffer[AUDIO_BUF_DBL];
+static int16_t audio_buffer[AUDIO_BUF_MAX] __attribute__((aligned(4))); /* Word DMA for 24/32-bit */
 
-#define REFILL_DONE 0
-#define REFILL_PING 1
-#define REFILL_PONG 2
-volatile static uint8_t buf_state = REFILL_DONE;
+/* Latency, frames per refill (16 to 256) and segments in the DMA ring (see audio.c) */
+#define LATENCY_BLOCK SAMPLE_BLOCK_SIZE
+#define LATENCY_SEGMENTS 2
+
+/* Uncomment to render from PendSV (see audio_render.c) rather than the super-loop */
+// #define RENDER_CALLBACK
+
+/* Uncomment to write I2S frames straight into the segment, no float block or pack */
+// #define RENDER_DIRECT
+
+/* Uncomment for the fixed-point plate (see plate.h) in DEMO_REVERB, not the FDN */
+// #define REVERB_PLATE
+
+/* Profiled sections, the whole refill must be section 0 */
+#define PROFILE_REFILL 0
+#define PROFILE_RENDER 1
+#define PROFILE_PACK 2
+#define PROFILE_REVERB 3 /* Inside render, DEMO_REVERB */
+static const char *profile_names[] = {"refill", "render", "pack", "reverb"};
 
 /* ----------------------------------------------------------------------------
- * Trivial test oscillators - no saw anti-aliasing and sine is only an approx.
+ * Test oscillators, one at a time - a band-limited saw (see osc_blep.h), a
+ * wavetable (see wavetable.h), a sine (see sine.h), a chord from a voice bank
+ * (see voice_bank.h), a 6 operator FM voice (see fm.h), pink noise (see noise.h),
+ * an additive organ (see additive.h), a stereo supersaw (see unison.h), a saw
+ * gliding between two notes (see ramp.h), a saw through a 24 dB/oct low pass (see
+ * biquad.h), a saw through a ladder filter swept by an envelope (see ladder.h), a
+ * saw through a stereo chorus (see delay.h) and short saw notes through a reverb
+ * (see fdn.h and plate.h).  Only the selected one's state, init and generator are
+ * compiled.
  */
+#define DEMO_SAW 0
+#define DEMO_WAVETABLE 1
+#define DEMO_SINE 2
+#define DEMO_CHORD 3
+#define DEMO_FM 4
+#define DEMO_NOISE 5
+#define DEMO_ADDITIVE 6
+#define DEMO_SUPERSAW 7
+#define DEMO_GLIDE 8
+#define DEMO_FILTERED 9
+#define DEMO_SWEEP 10
+#define DEMO_CHORUS 11
+#define DEMO_REVERB 12
+
+/* The test oscillator to play, one of the above */
+#define DEMO DEMO_SAW
+
+/* The stream (see audio.h), I2S_48_MCKOE_32 for the reverb so PROFILE_REVERB
+   reads against the README's deadline */
+#if DEMO == DEMO_REVERB
+#define AUDIO_MODE I2S_48_MCKOE_32
+#else
+#define AUDIO_MODE I2S_44_32
+#endif
+
 #define TEST_TONE 440.0f
 
-static float acc = 0.5f;
-static float sample_buffer[SAMPLE_BLOCK_SIZE];
+#if !defined(RENDER_DIRECT)
+static float test_fsr; /* pConfig->fsr, for the generators that change note */
+
+static float left_buffer[SAMPLE_BLOCK_MAX];
+static float right_buffer[SAMPLE_BLOCK_MAX];
+
+#if DEMO == DEMO_SAW
+static osc_blep_t saw;
+
+static void DemoInit(void)
+{
+	osc_blep_init(&saw, OSC_SAW, TEST_TONE, test_fsr);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	osc_blep_render(&saw, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_WAVETABLE
+static wavetable_osc_t table;
+
+static void DemoInit(void)
+{
+	wavetable_init(&table, WAVETABLE_CUBIC, TEST_TONE, test_fsr);
+	wavetable_set_morph(&table, 2.5f); /* Between saw and square */
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	wavetable_render(&table, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_SINE
+static sine_osc_t sine;
+
+static void DemoInit(void)
+{
+	sine_init(&sine, SINE_POLY, TEST_TONE, test_fsr);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	sine_render(&sine, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_CHORD
+static voice_bank_t chord;
+static int32_t chord_bus[SAMPLE_BLOCK_MAX];
 
-void GenerateSaw(float inc)
+static void DemoInit(void)
 {
-	for (int i = 0; i < SAMPLE_BLOCK_SIZE; i++)
+	voice_bank_init(&chord, PHASOR_TRIANGLE);
+	voice_bank_start(&chord, TEST_TONE, 0.25f, test_fsr); /* A major, A */
+	voice_bank_start(&chord, TEST_TONE * 1.25992f, 0.25f, test_fsr); /* C# */
+	voice_bank_start(&chord, TEST_TONE * 1.49831f, 0.25f, test_fsr); /* E */
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	memset(chord_bus, 0, frames * sizeof(int32_t));
+	voice_bank_render(&chord, chord_bus, frames);
+
+	for (size_t i = 0; i < frames; i++)
 	{
-		if (acc > 1.0f)
-		{
-			acc -= 1.0f;
-		}
+		left[i] = (float)chord_bus[i] * (1.0f / 1073741824.0f); /* Q30 */
+	}
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_FM
+static fm_voice_t fm;
+
+static void DemoInit(void)
+{
+	/* Electric piano-ish, three 2 operator stacks */
+	fm_init(&fm, FM_ALG_6_DX5, TEST_TONE, test_fsr);
+	for (int n = 0; n < FM_OPERATORS; n += 2)
+	{
+		fm_set_operator(&fm, n, 1.0f, 0.8f); /* Carrier */
+		fm_set_operator(&fm, n + 1, 1.0f + 6.0f * n, 0.3f); /* Modulator, ratios 1, 13, 25 */
+		fm_set_envelope(&fm, n, 0.002f, 1.5f, 0.3f, 0.3f);
+		fm_set_envelope(&fm, n + 1, 0.002f, 0.4f, 0.1f, 0.3f);
+	}
+	fm_set_feedback(&fm, 0.2f);
+	fm_note_on(&fm);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	fm_render(&fm, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_NOISE
+static noise_t noise;
+
+static void DemoInit(void)
+{
+	noise_init(&noise, NOISE_PINK, board_seed());
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	noise_render(&noise, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_ADDITIVE
+static additive_t organ;
+
+static void DemoInit(void)
+{
+	/* Drawbar organ, 16' 5 1/3' 8' 4' 2 2/3' 2' 1 3/5' 1 1/3' 1' */
+	static const float drawbars[] = {0.5f, 1.5f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 8.0f};
+
+	additive_init(&organ, TEST_TONE, test_fsr);
+	for (int n = 0; n < 9; n++)
+	{
+		additive_set_partial(&organ, n, drawbars[n], 0.1f, 0.0f);
+	}
+	additive_note_on(&organ);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	additive_render(&organ, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_SUPERSAW
+static unison_t supersaw;
+
+static void DemoInit(void)
+{
+	unison_init(&supersaw, 7, TEST_TONE, test_fsr);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	unison_render(&supersaw, left, right, frames);
+}
+
+#elif DEMO == DEMO_GLIDE
+static osc_blep_t glide;
+static size_t glide_frames; /* Into the current note */
+static bool glide_up;
+
+static void DemoInit(void)
+{
+	osc_blep_init(&glide, OSC_SAW, TEST_TONE, test_fsr);
+	osc_blep_set_glide(&glide, RAMP_ONE_POLE, 0.03f, test_fsr);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	/* A new note every half second, the glide carries on across the blocks */
+	glide_frames += frames;
+	if (glide_frames >= (size_t)(test_fsr * 0.5f))
+	{
+		glide_frames = 0;
+		glide_up = !glide_up;
+		osc_blep_set_frequency(&glide, glide_up ? TEST_TONE * 1.5f : TEST_TONE, test_fsr);
+	}
+
+	osc_blep_render(&glide, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_FILTERED
+static osc_blep_t bass;
+static biquad_t bass_filter;
+
+static void DemoInit(void)
+{
+	osc_blep_init(&bass, OSC_SAW, TEST_TONE / 4.0f, test_fsr);
+	biquad_init(&bass_filter, 2, test_fsr);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	/* Set every block as a patch would, the coefficients are only recomputed on a change */
+	biquad_set(&bass_filter, 0, BIQUAD_LOWPASS, 800.0f, 0.541f, 0.0f);
+	biquad_set(&bass_filter, 1, BIQUAD_LOWPASS, 800.0f, 1.307f, 0.0f);
+
+	osc_blep_render(&bass, left, frames);
+	biquad_process(&bass_filter, left, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_SWEEP
+static osc_blep_t bass;
+static ladder_t sweep_filter;
+static ramp_t sweep_envelope; /* Cutoff in Hz */
+static float sweep_cutoff[SAMPLE_BLOCK_MAX];
+static size_t sweep_frames; /* Into the current note */
+
+static void DemoInit(void)
+{
+	osc_blep_init(&bass, OSC_SAW, TEST_TONE / 4.0f, test_fsr);
+	ladder_init(&sweep_filter, 150.0f, 0.6f, test_fsr);
+	ramp_init(&sweep_envelope, RAMP_ONE_POLE, 150.0f, 0.08f, test_fsr);
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	/* Every half second the cutoff jumps up and falls back, a filter envelope */
+	sweep_frames += frames;
+	if (sweep_frames >= (size_t)(test_fsr * 0.5f))
+	{
+		sweep_frames = 0;
+		ramp_jump(&sweep_envelope, 6000.0f);
+		ramp_set_target(&sweep_envelope, 150.0f);
+	}
+
+	ramp_render(&sweep_envelope, sweep_cutoff, frames);
+	osc_blep_render(&bass, left, frames);
+	ladder_process_mod(&sweep_filter, left, sweep_cutoff, frames);
+	memcpy(right, left, frames * sizeof(float));
+}
+
+#elif DEMO == DEMO_CHORUS
+static osc_blep_t saw;
+static float chorus_buffer[DELAY_SIZE(11)] DELAY_RAM;
+static delay_t chorus;
+static float chorus_phase; /* LFO, 0 to 1 */
+static float chorus_rate; /* LFO increment per sample */
 
-		sample_buffer[i] = (2.0f * acc - 1.0f);
-		acc += inc;
+static void DemoInit(void)
+{
+	osc_blep_init(&saw, OSC_SAW, TEST_TONE, test_fsr);
+	delay_init(&chorus, chorus_buffer, DELAY_SIZE(11));
+	chorus_rate = 0.8f / test_fsr;
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	/* One line read at two taps swept in opposite directions, 7 ms +/- 2 ms */
+	const float centre = 0.007f * test_fsr;
+	const float depth = 0.002f * test_fsr;
+	float phase = chorus_phase;
+
+	osc_blep_render(&saw, left, frames);
+	for (size_t i = 0; i < frames; i++)
+	{
+		float lfo = sine_poly(phase);
+		float dry = left[i];
+		float wet_left = delay_read_lagrange(&chorus, centre + depth * lfo);
+		float wet_right = delay_read_lagrange(&chorus, centre - depth * lfo);
+
+		delay_write(&chorus, dry);
+		left[i] = 0.5f * (dry + wet_left);
+		right[i] = 0.5f * (dry + wet_right);
+		phase += chorus_rate;
+		phase -= phase >= 1.0f ? 1.0f : 0.0f;
+	}
+	chorus_phase = phase;
+}
+
+#elif DEMO == DEMO_REVERB
+static osc_blep_t saw;
+static size_t reverb_frames; /* Into the current note */
+#if defined(REVERB_PLATE)
+static plate_t plate;
+static int16_t reverb_ram[PLATE_RAM / sizeof(int16_t)] DELAY_RAM;
+#else
+static fdn_t reverb;
+#if defined(STM32F7)
+#define REVERB_PROFILE FDN_LUSH
+static float reverb_ram[FDN_LUSH_RAM / sizeof(float)] DELAY_RAM;
+#else
+#define REVERB_PROFILE FDN_COMPACT /* Host builds too */
+static int16_t reverb_ram[FDN_COMPACT_RAM / sizeof(int16_t)] DELAY_RAM;
+#endif
+#endif
+
+static void DemoInit(void)
+{
+	osc_blep_init(&saw, OSC_SAW, TEST_TONE, test_fsr);
+#if defined(REVERB_PLATE)
+	plate_init(&plate, reverb_ram, sizeof(reverb_ram), test_fsr);
+#else
+	fdn_init(&reverb, REVERB_PROFILE, reverb_ram, sizeof(reverb_ram), test_fsr);
+#endif
+}
+
+static void Generate(float *left, float *right, size_t frames)
+{
+	/* A 100 ms note every 750 ms, so the tail can be heard */
+	size_t note = (size_t)(test_fsr * 0.1f);
+	size_t period = (size_t)(test_fsr * 0.75f);
+
+	osc_blep_render(&saw, left, frames);
+	for (size_t i = 0; i < frames; i++)
+	{
+		left[i] = reverb_frames < note ? 0.5f * left[i] : 0.0f;
+		right[i] = left[i];
+		reverb_frames = reverb_frames + 1 < period ? reverb_frames + 1 : 0;
 	}
+
+	profile_begin(PROFILE_REVERB);
+#if defined(REVERB_PLATE)
+	plate_process(&plate, left, right, frames);
+#else
+	fdn_process(&reverb, left, right, frames);
+#endif
+	profile_end(PROFILE_REVERB);
 }
 
-const float PI = 3.1415926535897932384626433832795f;
-const float B = 4.0f / PI;
-const float C = -4.0f / (PI * PI);
-const float P = 0.225f;
+#else
+#error "DEMO must be one of the DEMO_ values"
+#endif
+
+/**
+ * @brief Renders a block of stereo samples, from the super-loop or PendSV.
+ *
+ * @param left Receives the left samples
+ * @param right Receives the right samples
+ * @param frames Number of samples
+ * @param ctx The audio config
+ */
+static void render(float *left, float *right, size_t frames, void *ctx)
+{
+	(void)ctx; /* The oscillators were set up from the config in main() */
+
+	profile_begin(PROFILE_RENDER);
+
+	Generate(left, right, frames);
 
-#include <math.h>
+	profile_end(PROFILE_RENDER);
+}
+
+#else
+/*
+ * Fixed-point saw (see phasor.h), written as frames as it goes
+ */
+static phasor_t direct_saw;
 
-void GenerateSineApproximation(float inc)
+static void GenerateSawDirect(int16_t *out, size_t frames, uint8_t bits)
 {
-	for (int i = 0; i < SAMPLE_BLOCK_SIZE; i++)
+	uint32_t *word = (uint32_t *)out;
+
+	if (bits == 16)
 	{
-		if (acc > 1.0f)
+		for (size_t i = 0; i < frames; i++)
 		{
-			acc -= 1.0f;
-		}
+			int32_t sample = phasor_q31_saw(phasor_next(&direct_saw)) >> 16;
 
-		float angle = -1.0f * (acc * 2.0f * PI - PI);
-		float y = B * angle + C * angle * fabsf(angle);
+			*word++ = audio_frame_16(sample, sample);
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < frames; i++)
+		{
+			uint32_t sample = audio_frame_32(phasor_q31_saw(phasor_next(&direct_saw)));
 
-		sample_buffer[i] = (P * (y * fabsf(y) - y) + y);
-		acc += inc;
+			*word++ = sample;
+			*word++ = sample;
+		}
 	}
 }
 
+/**
+ * @brief Renders a block of I2S frames straight into a segment (RENDER_DIRECT).
+ *
+ * @param out The segment to fill
+ * @param frames Number of frames
+ * @param ctx The audio config
+ */
+static void render_direct(int16_t *out, size_t frames, void *ctx)
+{
+	audio_config_t *pConfig = ctx;
+
+	profile_begin(PROFILE_RENDER);
+
+	GenerateSawDirect(out, frames, pConfig->bits);
+
+	profile_end(PROFILE_RENDER);
+}
+#endif
+
+/**
+ * @brief Hands a refill request from the DMA IRQ to the super-loop or PendSV.
+ *
+ * @param segment The segment to refill
+ */
+static void refill_request(int16_t *segment)
+{
+#if defined(RENDER_CALLBACK)
+	audio_render_request(segment);
+#else
+	audio_refill_request(segment);
+#endif
+}
+
 /* ----------------------------------------------------------------------------
  * Program entry point
  */
 int main(void)
 {
 
-	audio_config_t *pConfig = audio_streaming_run(audio_buffer, I2S_44_32);
+	audio_config_t *pConfig = audio_streaming_start(audio_buffer, AUDIO_MODE, LATENCY_BLOCK, LATENCY_SEGMENTS);
+
+	/* Cycle counts against the block deadline, see profile_get() */
+	profile_init(pConfig->block / pConfig->fsr, profile_names, 4);
+
+#if defined(RENDER_DIRECT)
+	phasor_init(&direct_saw, PHASOR_SAW, TEST_TONE, pConfig->fsr);
+#else
+	test_fsr = pConfig->fsr;
+	DemoInit();
+#endif
+
+#if defined(RENDER_CALLBACK) && defined(RENDER_DIRECT)
+	audio_render_direct_start(pConfig, render_direct, pConfig, AUDIO_RENDER_PRIORITY);
+#elif defined(RENDER_CALLBACK)
+	audio_render_start(pConfig, render, pConfig, AUDIO_RENDER_PRIORITY);
+#endif
 
 	/* Signal that all is well post configuration */
 	LED_BLUE_ON();
 
 	while (1)
 	{
-		if (buf_state != REFILL_DONE)
+#if defined(RENDER_CALLBACK)
+		/* Refills are run from PendSV */
+		int16_t *segment = NULL;
+#else
+		/* Oldest segment the DMA wants refilled */
+		int16_t *segment = audio_refill_next();
+#endif
+
+		if (segment != NULL)
 		{
+			profile_begin(PROFILE_REFILL);
 
-			PROBE1_SET();
-			GenerateSaw(TEST_TONE / pConfig->fsr);
-			//GenerateSineApproximation(TEST_TONE/pConfig->fsr);
-			
-
-			/* Determine buffer half to refill */
-			int16_t *ptr =
-					buf_state == REFILL_PING ? audio_buffer : audio_buffer + AUDIO_BUF_SGL;
-
-			if (pConfig->bits == 16)
-			{
-				for (int i = 0; i < SAMPLE_BLOCK_SIZE; i++)
-				{
-					int16_t sample = sample_buffer[i] * INT16_MAX;
-
-					/* LEFT + RIGHT */
-					*ptr++ = sample;
-					*ptr++ = sample;
-				}
-			}
-			else
-			{
-				for (int i = 0; i < SAMPLE_BLOCK_SIZE; i++)
-				{
-					int32_t sample = sample_buffer[i] * INT32_MAX;
-
-					/* LEFT + RIGHT */
-					*ptr++ = (int16_t)(sample >> 16); /* MSB in first word */
-					*ptr++ = (int16_t)(sample);				/* LSB in 2nd word */
-					*ptr++ = (int16_t)(sample >> 16);
-					*ptr++ = (int16_t)(sample);
-				}
-			}
-			buf_state = REFILL_DONE;
-			PROBE1_CLEAR();
+#if defined(RENDER_DIRECT)
+			/* Frames go straight into the segment */
+			render_direct(segment, pConfig->block, pConfig);
+#else
+			render(left_buffer, right_buffer, pConfig->block, pConfig);
+
+			/* Interleave and convert in one pass */
+			profile_begin(PROFILE_PACK);
+			pConfig->pack(left_buffer, right_buffer, segment, pConfig->block);
+			profile_end(PROFILE_PACK);
+#endif
+
+			/* Did the DMA get to this segment before we finished? */
+			audio_refill_done(segment);
+
+			profile_end(PROFILE_REFILL);
+		}
+		else
+		{
+			/* No refill required, do other stuff here */
 		}
 	}
 }
@@ -125,16 +560,16 @@ int main(void)
  */
 void DMA1_Stream5_IRQHandler(void)
 {	
-	/* TX complete - refill PONG */
+	/* TX complete - refill PONG, or the segment just sent (double-buffer) */
 	if (I2S_DMA->HISR & DMA_HISR_TCIF5)
 	{
 		I2S_DMA->HIFCR = DMA_HIFCR_CTCIF5;
-		buf_state = REFILL_PONG;
+		refill_request(audio_segment_done(true));
 	}
 	else
 	{
 		/* Half done - refill ping */
 		I2S_DMA->HIFCR = DMA_HIFCR_CHTIF5;
-		buf_state = REFILL_PING;
+		refill_request(audio_segment_done(false));
 	}
 }
@@ -0,0 +1,72 @@
+/**
+ * @file audio_convert.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Float to I2S frame conversion kernels
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Converts blocks of float samples (-1.0 to 1.0) to the I2S frames held in the DMA
+ * buffer, mono (copied to L and R) or planar stereo (interleaved), 16-bit or 24-in-32.
+ * Out of range samples saturate, so +1.0 gives full scale rather than wrapping.
+ *
+ * 24/32-bit frames are stored as halfword-swapped words, MSB halfword first in memory,
+ * for the word-wide DMA (see audio_streaming_start()).  The output must be word aligned.
+ *
+ * The _ref versions are plain C, one sample at a time, and define the results.  The
+ * others are unrolled by 4 and on Cortex-M4/M7 use VCVT to fixed point and SSAT, they
+ * give the same results bit for bit.  host/convert_bench.c compares the two.
+ *
+ * Fixed-point renderers can pack Q31 or Q15 blocks with the _q31 and _q15 kernels,
+ * which only rearrange the bits, or skip the block altogether and write whole frames
+ * into the segment with audio_frame_16() and audio_frame_32() (see
+ * audio_render_direct_start()).
+ */
+#ifndef HARDWARE_AUDIO_CONVERT_H_
+#define HARDWARE_AUDIO_CONVERT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+void audio_convert_mono_16(const float *in, int16_t *out, size_t frames);
+void audio_convert_mono_32(const float *in, int16_t *out, size_t frames);
+void audio_convert_stereo_16(const float *left, const float *right, int16_t *out, size_t frames);
+void audio_convert_stereo_32(const float *left, const float *right, int16_t *out, size_t frames);
+
+void audio_convert_mono_q31(const int32_t *in, int16_t *out, size_t frames);
+void audio_convert_stereo_q31(const int32_t *left, const int32_t *right, int16_t *out, size_t frames);
+void audio_convert_mono_q15(const int16_t *in, int16_t *out, size_t frames);
+void audio_convert_stereo_q15(const int16_t *left, const int16_t *right, int16_t *out, size_t frames);
+
+/**
+ * @brief One 16-bit L+R frame as the word stored in the DMA buffer.
+ *
+ * @param left Q15 left sample, L is sent first
+ * @param right Q15 right sample
+ * @return uint32_t The frame
+ */
+static inline uint32_t audio_frame_16(int32_t left, int32_t right)
+{
+	return ((uint32_t)left & 0xFFFFU) | ((uint32_t)right << 16);
+}
+
+/**
+ * @brief One 24/32-bit sample as the halfword-swapped word stored in the DMA buffer.
+ *
+ * @param sample Q31 sample, a frame is one of these for L then one for R
+ * @return uint32_t The sample, MSB halfword first in memory
+ */
+static inline uint32_t audio_frame_32(int32_t sample)
+{
+	return ((uint32_t)sample >> 16) | ((uint32_t)sample << 16);
+}
+
+void audio_convert_mono_16_ref(const float *in, int16_t *out, size_t frames);
+void audio_convert_mono_32_ref(const float *in, int16_t *out, size_t frames);
+void audio_convert_stereo_16_ref(const float *left, const float *right, int16_t *out, size_t frames);
+void audio_convert_stereo_32_ref(const float *left, const float *right, int16_t *out, size_t frames);
+
+#endif /* HARDWARE_AUDIO_CONVERT_H_ */
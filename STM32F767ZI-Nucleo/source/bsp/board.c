@@ -26,13 +26,13 @@
 #define APB1_BUS_SPEED 48000000
 #define APB2_BUS_SPEED 96000000
 #else
-/* Max out the clock, on this board that is 216MHz */
+/* Max out the clock, on this board that is 216MHz: 8MHz / 8 * 432 = 432MHz VCO, / 2 */
 #define PLL_M (LL_RCC_PLLM_DIV_8)
-#define PLL_N (216)
+#define PLL_N (432)
 #define PLL_P (LL_RCC_PLLP_DIV_2)
-#define PLL_Q (LL_RCC_PLLQ_DIV_2)
+#define PLL_Q (LL_RCC_PLLQ_DIV_9) /* 48MHz domain, for the RNG, must not exceed 48MHz */
 #define PLL_R (LL_RCC_PLLR_DIV_2)
-#define CORE_CLOCK_SPEED (21600000)
+#define CORE_CLOCK_SPEED (216000000)
 #define APB1_BUS_SPEED (54000000)
 #define APB2_BUS_SPEED (108000000)
 #endif
@@ -110,9 +110,8 @@ static void clock_init(void)
 	/* Set PLL dividers and source to HSE */
 	LL_RCC_PLL_ConfigDomain_SYS(LL_RCC_PLLSOURCE_HSE, PLL_M, PLL_N, PLL_P);
 
-#if defined(USB_ENABLED)
+	/* 48MHz domain for USB and the RNG (see board_seed()) */
 	LL_RCC_PLL_ConfigDomain_48M(LL_RCC_PLLSOURCE_HSE, PLL_M, PLL_N, PLL_Q);
-#endif
 
 	/* PLL on and wait for lock */
 	LL_RCC_PLL_Enable();
@@ -128,9 +127,9 @@ static void clock_init(void)
 
 	// SysTick_Config(CORE_CLOCK_SPEED / 1000);
 
-	/* Bus clock dividers */
-	LL_RCC_SetAPB1Prescaler(LL_RCC_SYSCLK_DIV_2);
-	LL_RCC_SetAPB2Prescaler(LL_RCC_SYSCLK_DIV_1);
+	/* Bus clock dividers, APB1 54MHz and APB2 108MHz at most */
+	LL_RCC_SetAPB1Prescaler(LL_RCC_APB1_DIV_4);
+	LL_RCC_SetAPB2Prescaler(LL_RCC_APB2_DIV_2);
 
 	/* Let CMSIS know */
 	SystemCoreClockUpdate();
@@ -251,3 +250,48 @@ void board_init(void)
 	/* FPU ON */
 	SCB->CPACR |= (3UL << 20 | 3UL << 22);	
 }
+
+/**
+ * @brief A seed for noise generators and the like, different every power up.
+ * @details Read from the RNG peripheral where the part has one (F7), mixed with the
+ * 96-bit unique ID and the cycle counter.  The F411 has no RNG, so there the ID and
+ * cycle counter are all there is, which still differs between boards and with the
+ * time taken to get here.  Not for cryptography.
+ * @param none
+ * @retval uint32_t The seed
+ */
+uint32_t board_seed(void)
+{
+	const uint32_t *uid = (const uint32_t *)UID_BASE;
+	uint32_t seed = uid[0] ^ (uid[1] * 0x9E3779B9U) ^ (uid[2] * 0x85EBCA6BU) ^ DWT->CYCCNT;
+
+#if defined(RNG)
+	LL_AHB2_GRP1_EnableClock(LL_AHB2_GRP1_PERIPH_RNG);
+	LL_RNG_Enable(RNG);
+
+	/* A few tens of RNG clocks, give up if the clock or seed checks fail */
+	for (uint32_t timeout = 100000; timeout > 0; timeout--)
+	{
+		if (LL_RNG_IsActiveFlag_CECS(RNG) || LL_RNG_IsActiveFlag_SECS(RNG))
+		{
+			break;
+		}
+		if (LL_RNG_IsActiveFlag_DRDY(RNG))
+		{
+			seed ^= LL_RNG_ReadRandData32(RNG);
+			break;
+		}
+	}
+
+	LL_RNG_Disable(RNG);
+	LL_AHB2_GRP1_DisableClock(LL_AHB2_GRP1_PERIPH_RNG);
+#endif
+
+	/* murmur3 finaliser, so similar IDs give unrelated seeds */
+	seed ^= seed >> 16;
+	seed *= 0x85EBCA6BU;
+	seed ^= seed >> 13;
+	seed *= 0xC2B2AE35U;
+	seed ^= seed >> 16;
+	return seed;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file profile.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Render budget profiler using the DWT cycle counter
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Wrap code in profile_begin()/profile_end() to collect min/max/mean timings for up
+ * to PROFILE_SECTIONS named sections.  profile_get() reports them as a percentage of
+ * the block deadline (block / fsr), i.e. how much of the refill budget is
+ * being used.  The section table is global so it can also be live-watched from the
+ * debugger.
+ *
+ * On the target the time base is DWT->CYCCNT (CPU cycles).  Host builds replace
+ * profile_now() with clock_gettime() and count nanoseconds (see host/profile_host.c).
+ * Section 0 is expected to be the whole refill.
+ */
+#ifndef HARDWARE_PROFILE_H_
+#define HARDWARE_PROFILE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if !defined(HOST_BUILD)
+#include "board.h"
+#endif
+
+#define PROFILE_SECTIONS 8
+
+typedef struct
+{
+	const char *name;
+	uint32_t start;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+	uint32_t count;
+} profile_section_t;
+
+typedef struct
+{
+	const char *name;
+	uint32_t count;
+	uint32_t min;				/* Ticks (cycles on target) */
+	uint32_t max;
+	uint32_t mean;
+	float usage_mean;		/* Percent of the block deadline */
+	float usage_max;
+} profile_stats_t;
+
+extern profile_section_t profile_sections[PROFILE_SECTIONS];
+
+#if defined(HOST_BUILD)
+#define PROFILE_CLOCK 1000000000UL /* Nanoseconds */
+uint32_t profile_now(void);
+#else
+#define PROFILE_CLOCK SystemCoreClock /* CPU cycles */
+static inline uint32_t profile_now(void)
+{
+	return DWT->CYCCNT;
+}
+#endif
+
+/**
+ * @brief Marks the start of a profiled section.
+ *
+ * @param id The section index
+ */
+static inline void profile_begin(uint8_t id)
+{
+	profile_sections[id].start = profile_now();
+}
+
+/**
+ * @brief Marks the end of a profiled section and accumulates the elapsed ticks.
+ *
+ * @param id The section index
+ */
+static inline void profile_end(uint8_t id)
+{
+	profile_section_t *s = &profile_sections[id];
+	uint32_t elapsed = profile_now() - s->start; /* Wraps safely */
+
+	if (elapsed < s->min)
+	{
+		s->min = elapsed;
+	}
+	if (elapsed > s->max)
+	{
+		s->max = elapsed;
+	}
+	s->total += elapsed;
+	s->count++;
+}
+
+void profile_init(float period, const char *names[], uint8_t count);
+void profile_reset(void);
+bool profile_get(uint8_t id, profile_stats_t *stats);
+
+#if defined(HOST_BUILD)
+void profile_print(void);
+#endif
+
+#endif /* HARDWARE_PROFILE_H_ */
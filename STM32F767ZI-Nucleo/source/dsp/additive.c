@@ -0,0 +1,303 @@
+/**
+ * @file additive.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Additive voice of up to 64 sine partials on recursive oscillators
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The outer loop is over pairs of active partials and the inner one over the block,
+ * so each output sample is loaded and stored once per pair.  Per partial and sample
+ * that leaves the resonator's multiply and subtract and a multiply-add of the ramped
+ * amplitude.
+ *
+ * A unit resonator keeps y1^2 + y2^2 - k y1 y2 = sin(w)^2.  Once a block the state is
+ * scaled by 1.5 - 0.5 E / sin(w)^2, one Newton step towards that, as the rotator in
+ * sine.c.  On a retune y2 is recomputed for the new w from the phase the old state
+ * gives, so the partial carries on where it was.
+ */
+#include <math.h>
+#include <stdbool.h>
+#include "additive.h"
+
+#define PI 3.14159265f
+#define LN_1000 6.90775528f /* -60 dB */
+
+/**
+ * @brief Sets partial n's resonator for ratio x frequency, keeping its phase.
+ */
+static void tune(additive_t *voice, int n, bool start)
+{
+	float w = 2.0f * PI * voice->ratio[n] * voice->frequency / voice->fsr;
+	float c = cosf(w);
+	float s = sinf(w);
+
+	if (w <= 0.0f || w >= PI)
+	{
+		/* Culled (see cull()), starts afresh if it comes back */
+		if (start)
+		{
+			voice->y1[n] = 0.0f;
+			voice->y2[n] = 0.0f;
+		}
+		return;
+	}
+
+	if (start || (voice->y1[n] == 0.0f && voice->y2[n] == 0.0f))
+	{
+		/* sin(0) and sin(-w) */
+		voice->y1[n] = 0.0f;
+		voice->y2[n] = -s;
+	}
+	else
+	{
+		/* The cosine of the phase, from the old state, gives y2 for the new w */
+		float cos_phase = (voice->y1[n] * 0.5f * voice->k[n] - voice->y2[n]) / sqrtf(voice->sin2[n]);
+
+		voice->y2[n] = voice->y1[n] * c - cos_phase * s;
+	}
+
+	voice->k[n] = 2.0f * c;
+	voice->sin2[n] = s * s;
+}
+
+/**
+ * @brief Lists the partials below fsr / 2.
+ */
+static void cull(additive_t *voice)
+{
+	float nyquist = 0.5f * voice->fsr;
+	uint8_t active = 0;
+
+	for (int n = 0; n < voice->count; n++)
+	{
+		float f = voice->ratio[n] * voice->frequency;
+
+		if (f > 0.0f && f < nyquist)
+		{
+			voice->index[active++] = (uint8_t)n;
+		}
+		else
+		{
+			voice->gain[n] = 0.0f; /* So it fades back in if it comes back */
+		}
+	}
+	voice->active = active;
+}
+
+/**
+ * @brief Steps the decays on by a block, the new targets.
+ */
+static void decay(additive_t *voice, size_t frames)
+{
+	if (frames != voice->factor_frames)
+	{
+		for (int n = 0; n < voice->count; n++)
+		{
+			voice->factor[n] = voice->decay[n] > 0.0f ? expf(-LN_1000 * frames / (voice->decay[n] * voice->fsr)) : 1.0f;
+		}
+		voice->factor_frames = frames;
+	}
+
+	for (int a = 0; a < voice->active; a++)
+	{
+		int n = voice->index[a];
+
+		voice->env[n] *= voice->factor[n];
+	}
+}
+
+static inline void normalise(additive_t *voice, int n)
+{
+	float y1 = voice->y1[n];
+	float y2 = voice->y2[n];
+	float energy = y1 * y1 + y2 * y2 - voice->k[n] * y1 * y2;
+	float g = 1.5f - 0.5f * energy / voice->sin2[n];
+
+	voice->y1[n] = y1 * g;
+	voice->y2[n] = y2 * g;
+}
+
+static void render(additive_t *voice, float *out, size_t frames, float gain, bool mix)
+{
+	float scale = 1.0f / frames;
+	int a = 0;
+
+	if (!mix)
+	{
+		for (size_t i = 0; i < frames; i++)
+		{
+			out[i] = 0.0f;
+		}
+	}
+
+	decay(voice, frames);
+
+	for (; a + 2 <= voice->active; a += 2)
+	{
+		int n0 = voice->index[a];
+		int n1 = voice->index[a + 1];
+		float g0 = gain * voice->gain[n0];
+		float g1 = gain * voice->gain[n1];
+		float step0 = (gain * voice->env[n0] - g0) * scale;
+		float step1 = (gain * voice->env[n1] - g1) * scale;
+		float k0 = voice->k[n0];
+		float k1 = voice->k[n1];
+		float a1 = voice->y1[n0];
+		float a2 = voice->y2[n0];
+		float b1 = voice->y1[n1];
+		float b2 = voice->y2[n1];
+
+		for (size_t i = 0; i < frames; i++)
+		{
+			float ya = k0 * a1 - a2;
+			float yb = k1 * b1 - b2;
+
+			a2 = a1;
+			a1 = ya;
+			b2 = b1;
+			b1 = yb;
+			out[i] += g0 * ya + g1 * yb;
+			g0 += step0;
+			g1 += step1;
+		}
+
+		voice->y1[n0] = a1;
+		voice->y2[n0] = a2;
+		voice->y1[n1] = b1;
+		voice->y2[n1] = b2;
+		voice->gain[n0] = voice->env[n0];
+		voice->gain[n1] = voice->env[n1];
+		normalise(voice, n0);
+		normalise(voice, n1);
+	}
+
+	/* An odd one out */
+	if (a < voice->active)
+	{
+		int n = voice->index[a];
+		float g = gain * voice->gain[n];
+		float step = (gain * voice->env[n] - g) * scale;
+		float k = voice->k[n];
+		float y1 = voice->y1[n];
+		float y2 = voice->y2[n];
+
+		for (size_t i = 0; i < frames; i++)
+		{
+			float y = k * y1 - y2;
+
+			y2 = y1;
+			y1 = y;
+			out[i] += g * y;
+			g += step;
+		}
+
+		voice->y1[n] = y1;
+		voice->y2[n] = y2;
+		voice->gain[n] = voice->env[n];
+		normalise(voice, n);
+	}
+}
+
+/**
+ * @brief Sets up a voice with no partials.
+ *
+ * @param voice The voice
+ * @param frequency In Hz
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void additive_init(additive_t *voice, float frequency, float fsr)
+{
+	voice->frequency = frequency;
+	voice->fsr = fsr;
+	voice->count = 0;
+	voice->active = 0;
+	voice->factor_frames = 0;
+}
+
+/**
+ * @brief Sets a partial, partials from count up to it are added silent.
+ *
+ * @param voice The voice
+ * @param partial 0 to ADDITIVE_PARTIALS - 1
+ * @param ratio Multiple of the voice frequency, culled at fsr / 2
+ * @param level Amplitude at note on, the sum of all of them should be 1 or less
+ * @param decay Seconds to fall 60 dB, 0 to hold
+ */
+void additive_set_partial(additive_t *voice, int partial, float ratio, float level, float decay)
+{
+	while (voice->count <= partial)
+	{
+		int n = voice->count++;
+
+		voice->ratio[n] = 0.0f;
+		voice->level[n] = 0.0f;
+		voice->decay[n] = 0.0f;
+		voice->env[n] = 0.0f;
+		voice->gain[n] = 0.0f;
+	}
+
+	voice->ratio[partial] = ratio;
+	voice->level[partial] = level;
+	voice->decay[partial] = decay;
+	voice->factor_frames = 0;
+	tune(voice, partial, true);
+	cull(voice);
+}
+
+/**
+ * @brief Changes the voice frequency, the partials follow at their ratios.
+ *
+ * @param voice The voice
+ * @param frequency In Hz
+ */
+void additive_set_frequency(additive_t *voice, float frequency)
+{
+	voice->frequency = frequency;
+	for (int n = 0; n < voice->count; n++)
+	{
+		tune(voice, n, false);
+	}
+	cull(voice);
+}
+
+/**
+ * @brief Starts every partial at its level, decaying from there.
+ *
+ * @param voice The voice
+ */
+void additive_note_on(additive_t *voice)
+{
+	for (int n = 0; n < voice->count; n++)
+	{
+		voice->env[n] = voice->level[n];
+	}
+}
+
+/**
+ * @brief Renders a block of samples.
+ *
+ * @param voice The voice
+ * @param out Receives the samples
+ * @param frames Number of samples
+ */
+void additive_render(additive_t *voice, float *out, size_t frames)
+{
+	render(voice, out, frames, 1.0f, false);
+}
+
+/**
+ * @brief Adds a block of samples to out.
+ *
+ * @param voice The voice
+ * @param out Samples to add to
+ * @param frames Number of samples
+ * @param gain Applied before adding
+ */
+void additive_mix(additive_t *voice, float *out, size_t frames, float gain)
+{
+	render(voice, out, frames, gain, true);
+}
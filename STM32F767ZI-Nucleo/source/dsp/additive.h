@@ -0,0 +1,62 @@
+/**
+ * @file additive.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Additive voice of up to 64 sine partials on recursive oscillators
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Each partial is a Goertzel-style resonator, y[n] = k y[n-1] - y[n-2] with
+ * k = 2 cos(w), a multiply and a subtract per sample rather than a phase accumulator
+ * and table read.  Partials have a frequency ratio to the voice, a level and an
+ * exponential decay, for bells and plucks.  Set the decay to 0 for an organ.
+ *
+ * Amplitudes are updated once a block and ramped across it.  Partials at or above
+ * fsr / 2 are culled when the frequency or a ratio changes, so there is no aliasing
+ * and no work for them.  The resonators run at unit amplitude and are pulled back
+ * to it once a block (they drift slowly from rounding), and a frequency change keeps
+ * each partial's phase, so it can be swept without clicks.
+ *
+ * The state is in struct-of-arrays layout, as voice_bank.h, so the render loop steps
+ * through the active partials two at a time.
+ */
+#ifndef DSP_ADDITIVE_H_
+#define DSP_ADDITIVE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ADDITIVE_PARTIALS 64
+
+typedef struct
+{
+	float frequency;
+	float fsr;
+	uint8_t count; /* Partials set, 0 to count - 1 */
+	uint8_t active; /* Partials below fsr / 2 */
+	uint8_t index[ADDITIVE_PARTIALS]; /* Of the active partials */
+	float ratio[ADDITIVE_PARTIALS]; /* To the voice frequency */
+	float level[ADDITIVE_PARTIALS]; /* Amplitude at note on */
+	float decay[ADDITIVE_PARTIALS]; /* Seconds to -60 dB, 0 for none */
+	float env[ADDITIVE_PARTIALS]; /* level x decay so far */
+	float gain[ADDITIVE_PARTIALS]; /* Amplitude at the end of the last block */
+	float k[ADDITIVE_PARTIALS]; /* 2 cos(w) */
+	float sin2[ADDITIVE_PARTIALS]; /* sin(w)^2, the resonator energy at unit amplitude */
+	float y1[ADDITIVE_PARTIALS]; /* Resonator state */
+	float y2[ADDITIVE_PARTIALS];
+	float factor[ADDITIVE_PARTIALS]; /* Decay per block of factor_frames */
+	size_t factor_frames;
+} additive_t;
+
+void additive_init(additive_t *voice, float frequency, float fsr);
+void additive_set_partial(additive_t *voice, int partial, float ratio, float level, float decay);
+void additive_set_frequency(additive_t *voice, float frequency);
+void additive_note_on(additive_t *voice);
+
+void additive_render(additive_t *voice, float *out, size_t frames);
+void additive_mix(additive_t *voice, float *out, size_t frames, float gain);
+
+#endif /* DSP_ADDITIVE_H_ */
@@ -0,0 +1,440 @@
+/**
+ * @file fm.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief 4 and 6 operator FM (phase modulation) voice
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * A block is rendered FM_BLOCK samples at a time, one operator at a time, from the
+ * highest numbered down.  Each operator writes its FM_BLOCK of output to the scratch
+ * buffer, where the operators it modulates pick it up as their phase offset (summed
+ * first if there are several).  The carriers' blocks are then summed to the output.
+ *
+ * The operator loop is a phase add, the offset added to the phase, an interpolated
+ * table read and a multiply by the ramped level.  Whether there is a modulator and
+ * whether the operator has feedback are constants at each call of run(), so the loop
+ * has no branches.  The offset is converted to phase as (int32_t)(cycles x 2^24)
+ * shifted up by 8, which wraps correctly without 64-bit arithmetic.
+ */
+#include "fm.h"
+#include "phasor.h"
+#include "sine.h"
+
+#define MOD_CYCLES 2.0f /* Phase shift of a full level modulator */
+
+/* Operator outputs for the current FM_BLOCK, plus a sum of several modulators */
+static float scratch[FM_OPERATORS][FM_BLOCK];
+static float mod_sum[FM_BLOCK];
+
+#define ALG(ops, carriers, feedback, ...) {ops, carriers, feedback, {__VA_ARGS__}}
+#define OP(n) (1U << (n))
+
+const fm_algorithm_t fm_algorithms[FM_ALGORITHMS] = {
+		[FM_ALG_4_STACK] = ALG(4, OP(0), 3, OP(1), OP(2), OP(3), 0),
+		[FM_ALG_4_TWO_STACKS] = ALG(4, OP(0) | OP(2), 3, OP(1), 0, OP(3), 0),
+		[FM_ALG_4_BRANCH] = ALG(4, OP(0), 3, OP(1), OP(2) | OP(3), 0, 0),
+		[FM_ALG_4_ONE_TO_THREE] = ALG(4, OP(0) | OP(1) | OP(2), 3, OP(3), OP(3), OP(3), 0),
+		[FM_ALG_4_PARALLEL] = ALG(4, OP(0) | OP(1) | OP(2) | OP(3), 3, 0, 0, 0, 0),
+		[FM_ALG_6_DX1] = ALG(6, OP(0) | OP(2), 5, OP(1), 0, OP(3), OP(4), OP(5), 0),
+		[FM_ALG_6_DX5] = ALG(6, OP(0) | OP(2) | OP(4), 5, OP(1), 0, OP(3), 0, OP(5), 0),
+		[FM_ALG_6_DX7] = ALG(6, OP(0) | OP(2), 5, OP(1), 0, OP(3) | OP(4), 0, OP(5), 0),
+		[FM_ALG_6_DX22] = ALG(6, OP(0) | OP(2) | OP(3) | OP(4), 5, OP(1), 0, OP(5), OP(5), OP(5), 0),
+		[FM_ALG_6_DX32] = ALG(6, 0x3F, 5, 0, 0, 0, 0, 0, 0),
+};
+
+static inline float table_sine(uint32_t phase)
+{
+	uint32_t index = phase >> 22;
+	float frac = (float)(phase & 0x3FFFFFU) * (1.0f / 4194304.0f);
+	float a = sine_table_1024[index];
+
+	return a + frac * (sine_table_1024[index + 1] - a);
+}
+
+static inline uint32_t to_phase(float cycles)
+{
+	return (uint32_t)(int32_t)(cycles * 16777216.0f) << 8;
+}
+
+static inline void run(fm_voice_t *voice, fm_op_t *op, const float *mod, float *out, int frames, float gain, float step, bool modulated, bool feedback)
+{
+	uint32_t phase = op->phase;
+	uint32_t inc = op->inc;
+	float fb = voice->feedback * 0.5f * MOD_CYCLES;
+	float y1 = voice->fb[0];
+	float y2 = voice->fb[1];
+
+	for (int i = 0; i < frames; i++)
+	{
+		uint32_t p = phase;
+
+		if (modulated)
+		{
+			p += to_phase(MOD_CYCLES * mod[i]);
+		}
+		if (feedback)
+		{
+			p += to_phase(fb * (y1 + y2));
+		}
+
+		float y = gain * table_sine(p);
+
+		if (feedback)
+		{
+			y2 = y1;
+			y1 = y;
+		}
+		out[i] = y;
+		gain += step;
+		phase += inc;
+	}
+
+	op->phase = phase;
+	if (feedback)
+	{
+		voice->fb[0] = y1;
+		voice->fb[1] = y2;
+	}
+}
+
+/**
+ * @brief Steps an envelope on by part of an FM_BLOCK.
+ *
+ * @param env The envelope
+ * @param part Samples / FM_BLOCK, 1 except for the end of an odd sized block
+ * @return float The level at the end of the block
+ */
+static float env_step(fm_env_t *env, float part)
+{
+	switch (env->state)
+	{
+	case FM_ENV_ATTACK:
+		env->level += env->attack * part;
+		if (env->level >= 1.0f)
+		{
+			env->level = 1.0f;
+			env->state = FM_ENV_DECAY;
+		}
+		break;
+	case FM_ENV_DECAY:
+		env->level -= env->decay * part;
+		if (env->level <= env->sustain)
+		{
+			env->level = env->sustain;
+			env->state = FM_ENV_SUSTAIN;
+		}
+		break;
+	case FM_ENV_RELEASE:
+		env->level -= env->release * part;
+		if (env->level <= 0.0f)
+		{
+			env->level = 0.0f;
+			env->state = FM_ENV_IDLE;
+		}
+		break;
+	default:
+		break;
+	}
+	return env->level;
+}
+
+/**
+ * @brief Renders up to FM_BLOCK samples of every operator into scratch[].
+ */
+static void render_block(fm_voice_t *voice, int frames)
+{
+	const fm_algorithm_t *alg = voice->algorithm;
+	float part = (float)frames * (1.0f / FM_BLOCK);
+
+	for (int n = alg->operators - 1; n >= 0; n--)
+	{
+		fm_op_t *op = &voice->op[n];
+		float start = op->gain;
+		float end = op->level * env_step(&op->env, part);
+		float step = (end - start) / frames;
+		uint8_t mods = alg->mod[n];
+		const float *mod = NULL;
+
+		op->gain = end;
+
+		/* Nothing to hear, keep the phase going so the note stays in tune */
+		if (start == 0.0f && end == 0.0f)
+		{
+			for (int i = 0; i < frames; i++)
+			{
+				scratch[n][i] = 0.0f;
+			}
+			op->phase += op->inc * (uint32_t)frames;
+			if (n == alg->feedback)
+			{
+				voice->fb[0] = 0.0f;
+				voice->fb[1] = 0.0f;
+			}
+			continue;
+		}
+
+		/* One modulator is read in place, several are summed */
+		if (mods != 0 && (mods & (mods - 1)) == 0)
+		{
+			mod = scratch[__builtin_ctz(mods)];
+		}
+		else if (mods != 0)
+		{
+			for (int i = 0; i < frames; i++)
+			{
+				mod_sum[i] = 0.0f;
+			}
+			for (int m = n + 1; m < alg->operators; m++)
+			{
+				if (mods & OP(m))
+				{
+					for (int i = 0; i < frames; i++)
+					{
+						mod_sum[i] += scratch[m][i];
+					}
+				}
+			}
+			mod = mod_sum;
+		}
+
+		if (n == alg->feedback && voice->feedback != 0.0f)
+		{
+			if (mod != NULL)
+			{
+				run(voice, op, mod, scratch[n], frames, start, step, true, true);
+			}
+			else
+			{
+				run(voice, op, NULL, scratch[n], frames, start, step, false, true);
+			}
+		}
+		else if (mod != NULL)
+		{
+			run(voice, op, mod, scratch[n], frames, start, step, true, false);
+		}
+		else
+		{
+			run(voice, op, NULL, scratch[n], frames, start, step, false, false);
+		}
+	}
+}
+
+static void render(fm_voice_t *voice, float *out, size_t frames, float gain, bool mix)
+{
+	const fm_algorithm_t *alg = voice->algorithm;
+
+	gain *= voice->carrier_gain;
+
+	while (frames > 0)
+	{
+		int n = frames < FM_BLOCK ? (int)frames : FM_BLOCK;
+
+		render_block(voice, n);
+
+		if (!mix)
+		{
+			for (int i = 0; i < n; i++)
+			{
+				out[i] = 0.0f;
+			}
+		}
+		for (int c = 0; c < alg->operators; c++)
+		{
+			if (alg->carriers & OP(c))
+			{
+				for (int i = 0; i < n; i++)
+				{
+					out[i] += gain * scratch[c][i];
+				}
+			}
+		}
+
+		out += n;
+		frames -= (size_t)n;
+	}
+}
+
+/**
+ * @brief Sets up a voice, every operator at ratio 1, level 0 and an organ envelope.
+ *
+ * @param voice The voice
+ * @param algorithm One of fm_algorithm_id_t
+ * @param frequency In Hz
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void fm_init(fm_voice_t *voice, fm_algorithm_id_t algorithm, float frequency, float fsr)
+{
+	voice->fsr = fsr;
+	voice->frequency = frequency;
+	voice->feedback = 0.0f;
+	voice->fb[0] = 0.0f;
+	voice->fb[1] = 0.0f;
+
+	for (int n = 0; n < FM_OPERATORS; n++)
+	{
+		fm_op_t *op = &voice->op[n];
+
+		op->phase = 0;
+		op->gain = 0.0f;
+		op->env.state = FM_ENV_IDLE;
+		op->env.level = 0.0f;
+		fm_set_operator(voice, n, 1.0f, 0.0f);
+		fm_set_envelope(voice, n, 0.0f, 0.0f, 1.0f, 0.0f);
+	}
+
+	fm_set_algorithm(voice, algorithm);
+	fm_set_frequency(voice, frequency);
+}
+
+/**
+ * @brief Changes the algorithm, the operators carry on.
+ *
+ * @param voice The voice
+ * @param algorithm One of fm_algorithm_id_t
+ */
+void fm_set_algorithm(fm_voice_t *voice, fm_algorithm_id_t algorithm)
+{
+	const fm_algorithm_t *alg = &fm_algorithms[algorithm];
+
+	voice->algorithm = alg;
+	voice->carrier_gain = 1.0f / __builtin_popcount(alg->carriers);
+}
+
+/**
+ * @brief Changes the voice frequency, the operators follow at their ratios.
+ *
+ * @param voice The voice
+ * @param frequency In Hz
+ */
+void fm_set_frequency(fm_voice_t *voice, float frequency)
+{
+	voice->frequency = frequency;
+	for (int n = 0; n < FM_OPERATORS; n++)
+	{
+		voice->op[n].inc = phasor_increment(frequency * voice->op[n].ratio, voice->fsr);
+	}
+}
+
+/**
+ * @brief Sets an operator's frequency ratio and output level.
+ *
+ * @param voice The voice
+ * @param op Operator, 0 to FM_OPERATORS - 1
+ * @param ratio Multiple of the voice frequency, keep the product below fsr / 2, it is held below fsr
+ * @param level 0 to 1, for a modulator 1 is an index of 4 pi
+ */
+void fm_set_operator(fm_voice_t *voice, int op, float ratio, float level)
+{
+	voice->op[op].ratio = ratio;
+	voice->op[op].level = level;
+	voice->op[op].inc = phasor_increment(voice->frequency * ratio, voice->fsr);
+}
+
+/**
+ * @brief Sets an operator's envelope, times of 0 are immediate.
+ *
+ * @param voice The voice
+ * @param op Operator, 0 to FM_OPERATORS - 1
+ * @param attack Seconds from 0 to 1
+ * @param decay Seconds from 1 to 0, it stops at the sustain level
+ * @param sustain 0 to 1
+ * @param release Seconds from 1 to 0
+ */
+void fm_set_envelope(fm_voice_t *voice, int op, float attack, float decay, float sustain, float release)
+{
+	fm_env_t *env = &voice->op[op].env;
+	float blocks = voice->fsr / FM_BLOCK; /* Per second */
+
+	env->attack = attack > 0.0f ? 1.0f / (attack * blocks) : 1.0f;
+	env->decay = decay > 0.0f ? 1.0f / (decay * blocks) : 1.0f;
+	env->sustain = sustain;
+	env->release = release > 0.0f ? 1.0f / (release * blocks) : 1.0f;
+}
+
+/**
+ * @brief Feedback for the algorithm's feedback operator.
+ *
+ * @param voice The voice
+ * @param feedback 0 to 1, at 1 the mean of the last two samples moves the phase up
+ * to 2 cycles (4 pi), the same as a full level modulator
+ */
+void fm_set_feedback(fm_voice_t *voice, float feedback)
+{
+	voice->feedback = feedback;
+}
+
+/**
+ * @brief Starts the envelopes, from their current levels.
+ *
+ * @param voice The voice
+ */
+void fm_note_on(fm_voice_t *voice)
+{
+	for (int n = 0; n < FM_OPERATORS; n++)
+	{
+		voice->op[n].env.state = FM_ENV_ATTACK;
+	}
+}
+
+/**
+ * @brief Releases the envelopes.
+ *
+ * @param voice The voice
+ */
+void fm_note_off(fm_voice_t *voice)
+{
+	for (int n = 0; n < FM_OPERATORS; n++)
+	{
+		if (voice->op[n].env.state != FM_ENV_IDLE)
+		{
+			voice->op[n].env.state = FM_ENV_RELEASE;
+		}
+	}
+}
+
+/**
+ * @brief Is any carrier still sounding?
+ *
+ * @param voice The voice
+ * @return true Until the carriers have released
+ */
+bool fm_active(const fm_voice_t *voice)
+{
+	for (int n = 0; n < voice->algorithm->operators; n++)
+	{
+		if ((voice->algorithm->carriers & OP(n)) && (voice->op[n].env.state != FM_ENV_IDLE || voice->op[n].gain != 0.0f))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Renders a block of samples.
+ *
+ * @param voice The voice
+ * @param out Receives the samples
+ * @param frames Number of samples
+ */
+void fm_render(fm_voice_t *voice, float *out, size_t frames)
+{
+	render(voice, out, frames, 1.0f, false);
+}
+
+/**
+ * @brief Adds a block of samples to out.
+ *
+ * @param voice The voice
+ * @param out Samples to add to
+ * @param frames Number of samples
+ * @param gain Applied before adding
+ */
+void fm_mix(fm_voice_t *voice, float *out, size_t frames, float gain)
+{
+	render(voice, out, frames, gain, true);
+}
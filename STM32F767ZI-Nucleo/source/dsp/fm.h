@@ -0,0 +1,116 @@
+/**
+ * @file fm.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief 4 and 6 operator FM (phase modulation) voice
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Each operator is a sine on a uint32_t phase accumulator (as phasor.h) reading
+ * sine_table_1024, with a frequency ratio to the voice, an output level and an ADSR
+ * envelope.  The algorithm (fm_algorithms[]) says which operators modulate which and
+ * which are carriers, summed to the output.  One operator per algorithm has feedback
+ * from its own last two samples, as on the DX7.
+ *
+ * Operators are numbered from 0, which is always a carrier, and only higher numbered
+ * operators modulate lower ones, so they are rendered from the top down.  A modulator
+ * at full level shifts its targets' phase by up to 2 cycles, an index of 4 pi.
+ *
+ * Envelopes run at FM_BLOCK rate and the level is ramped linearly across each
+ * FM_BLOCK, so there is no zipper noise.  Silent operators are skipped.
+ *
+ * The voice renders through a shared scratch buffer, so render one voice at a time
+ * (from the super-loop or PendSV, not both).  See the README for the cycle budget.
+ */
+#ifndef DSP_FM_H_
+#define DSP_FM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FM_OPERATORS 6
+#define FM_BLOCK 32 /* Envelope rate and scratch size, in samples */
+
+typedef enum
+{
+	FM_ALG_4_STACK, /* 3 > 2 > 1 > 0 */
+	FM_ALG_4_TWO_STACKS, /* 1 > 0, 3 > 2 */
+	FM_ALG_4_BRANCH, /* (2 + 3) > 1 > 0 */
+	FM_ALG_4_ONE_TO_THREE, /* 3 > (0, 1, 2) */
+	FM_ALG_4_PARALLEL, /* 0, 1, 2, 3 all carriers */
+	FM_ALG_6_DX1, /* 1 > 0, 5 > 4 > 3 > 2 */
+	FM_ALG_6_DX5, /* 1 > 0, 3 > 2, 5 > 4 */
+	FM_ALG_6_DX7, /* 1 > 0, (3 + 4) > 2, 5 > 4 */
+	FM_ALG_6_DX22, /* 1 > 0, 5 > (2, 3, 4) */
+	FM_ALG_6_DX32, /* 0 to 5 all carriers */
+	FM_ALGORITHMS
+} fm_algorithm_id_t;
+
+typedef struct
+{
+	uint8_t operators; /* 4 or 6 */
+	uint8_t carriers; /* Bit per operator */
+	uint8_t feedback; /* The operator with feedback */
+	uint8_t mod[FM_OPERATORS]; /* Bit per operator modulating each operator */
+} fm_algorithm_t;
+
+extern const fm_algorithm_t fm_algorithms[FM_ALGORITHMS];
+
+typedef enum
+{
+	FM_ENV_IDLE,
+	FM_ENV_ATTACK,
+	FM_ENV_DECAY,
+	FM_ENV_SUSTAIN,
+	FM_ENV_RELEASE
+} fm_env_state_t;
+
+typedef struct
+{
+	fm_env_state_t state;
+	float level;
+	float attack; /* Level change per FM_BLOCK */
+	float decay;
+	float sustain; /* 0 to 1 */
+	float release;
+} fm_env_t;
+
+typedef struct
+{
+	uint32_t phase; /* A cycle is 2^32 */
+	uint32_t inc;
+	float ratio; /* To the voice frequency */
+	float level; /* 0 to 1 */
+	fm_env_t env;
+	float gain; /* level x envelope at the end of the last FM_BLOCK */
+} fm_op_t;
+
+typedef struct
+{
+	const fm_algorithm_t *algorithm;
+	float carrier_gain; /* 1 / carriers */
+	float frequency;
+	float fsr;
+	float feedback; /* 0 to 1 */
+	float fb[2]; /* The feedback operator's last two samples */
+	fm_op_t op[FM_OPERATORS];
+} fm_voice_t;
+
+void fm_init(fm_voice_t *voice, fm_algorithm_id_t algorithm, float frequency, float fsr);
+void fm_set_algorithm(fm_voice_t *voice, fm_algorithm_id_t algorithm);
+void fm_set_frequency(fm_voice_t *voice, float frequency);
+void fm_set_operator(fm_voice_t *voice, int op, float ratio, float level);
+void fm_set_envelope(fm_voice_t *voice, int op, float attack, float decay, float sustain, float release);
+void fm_set_feedback(fm_voice_t *voice, float feedback);
+void fm_note_on(fm_voice_t *voice);
+void fm_note_off(fm_voice_t *voice);
+bool fm_active(const fm_voice_t *voice);
+
+void fm_render(fm_voice_t *voice, float *out, size_t frames);
+void fm_mix(fm_voice_t *voice, float *out, size_t frames, float gain);
+
+#endif /* DSP_FM_H_ */
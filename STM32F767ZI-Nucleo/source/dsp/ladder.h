@@ -0,0 +1,52 @@
+/**
+ * @file ladder.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Zero-delay-feedback 4-pole ladder low pass with an audio rate cutoff
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The 24 dB/oct transistor ladder: four one-pole low passes in series with the
+ * output fed back to the input, built from trapezoidal one-poles with the feedback
+ * loop solved exactly each sample (Zavalishin's TPT), so there is no unit delay in
+ * the loop and the resonance peak lands at the cutoff.  The response, against the
+ * analogue prototype with s normalised to the cutoff, is
+ *
+ *   (1 + k) / ((1 + s)^4 + k)        k = 4 x resonance
+ *
+ * The input is scaled by 1 + k so the pass band stays at 0 dB as the resonance goes
+ * up.  The model is linear: at a resonance of 1 the filter is on the edge of
+ * self-oscillation and rings for ever, it is held there.
+ *
+ * As svf.h, ladder_process() runs at the cutoff set by ladder_set_cutoff() and
+ * ladder_process_mod() takes a cutoff in Hz for every sample, with one divide per
+ * sample for both the prewarp and the feedback.
+ */
+#ifndef DSP_LADDER_H_
+#define DSP_LADDER_H_
+
+#include <stddef.h>
+
+typedef struct
+{
+	float cutoff; /* Hz */
+	float resonance; /* 0 to 1 */
+	float k; /* Feedback, 4 x resonance */
+	float scale; /* pi / fsr, for the prewarp */
+	float G; /* One-pole gain g / (1 + g) */
+	float h; /* 1 / (1 + k G^4), the feedback solution */
+	float s[4]; /* One-pole states */
+} ladder_t;
+
+void ladder_init(ladder_t *ladder, float cutoff, float resonance, float fsr);
+void ladder_set_cutoff(ladder_t *ladder, float cutoff);
+void ladder_set_resonance(ladder_t *ladder, float resonance);
+void ladder_reset(ladder_t *ladder);
+
+void ladder_process(ladder_t *ladder, float *buffer, size_t frames);
+void ladder_process_mod(ladder_t *ladder, float *buffer, const float *cutoff, size_t frames);
+
+#endif /* DSP_LADDER_H_ */
@@ -0,0 +1,278 @@
+/**
+ * @file osc_blep.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Band-limited saw, pulse and triangle oscillators (PolyBLEP/PolyBLAMP)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The residuals are those of a linear (two-sample triangle) band-limited impulse, in
+ * terms of the phase t and increment dt.  For a step of 2, one sample either side:
+ *
+ *   blep(t)  = 2x - x^2 - 1        x = t / dt,        0 <= t < dt
+ *            = x^2 + 2x + 1        x = (t - 1) / dt,  1 - dt < t < 1
+ *
+ * and its integral for a change of slope of 1 per sample:
+ *
+ *   blamp(t) = (1 - x)^3 / 6       x = t / dt
+ *            = (1 + x)^3 / 6       x = (t - 1) / dt
+ *
+ * The triangle's slope changes by 8 * dt per sample at each corner.  1 / dt is worked
+ * out once per block, or once per sample while gliding, when the increment steps.
+ */
+#include <stdbool.h>
+#include "osc_blep.h"
+
+static inline float blamp(float t, float dt, float rdt)
+{
+	if (t < dt)
+	{
+		t = 1.0f - t * rdt;
+		return t * t * t * (1.0f / 6.0f);
+	}
+	if (t > 1.0f - dt)
+	{
+		t = 1.0f + (t - 1.0f) * rdt;
+		return t * t * t * (1.0f / 6.0f);
+	}
+	return 0.0f;
+}
+
+static inline float wrap(float t)
+{
+	return t >= 1.0f ? t - 1.0f : t;
+}
+
+/* ----------------------------------------------------------------------------
+ * One loop per shape, mix is a constant so each call site gets its own copy
+ */
+static inline void saw(osc_blep_t *osc, float *out, size_t frames, float gain, bool mix, bool glide)
+{
+	float t = osc->phase;
+	float dt = osc->inc.value;
+	float rdt = 1.0f / dt;
+	const ramp_t ramp = osc->inc; /* A local, so the step stays in registers */
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		if (glide)
+		{
+			dt = ramp_step(&ramp, dt);
+			rdt = 1.0f / dt;
+		}
+
+		float y = 2.0f * t - 1.0f - osc_polyblep(t, dt, rdt);
+
+		out[i] = mix ? out[i] + gain * y : y;
+		t = wrap(t + dt);
+	}
+	osc->phase = t;
+	if (glide)
+	{
+		ramp_advance(&osc->inc, frames, dt);
+	}
+}
+
+static inline void pulse(osc_blep_t *osc, float *out, size_t frames, float gain, bool mix, bool glide)
+{
+	float t = osc->phase;
+	float dt = osc->inc.value;
+	float rdt = 1.0f / dt;
+	const ramp_t ramp = osc->inc;
+	float w = osc->width;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		if (glide)
+		{
+			dt = ramp_step(&ramp, dt);
+			rdt = 1.0f / dt;
+		}
+
+		/* Rises at t = 0 and falls at t = width */
+		float fall = t >= w ? t - w : t - w + 1.0f;
+		float y = (t < w ? 1.0f : -1.0f) + osc_polyblep(t, dt, rdt) - osc_polyblep(fall, dt, rdt);
+
+		out[i] = mix ? out[i] + gain * y : y;
+		t = wrap(t + dt);
+	}
+	osc->phase = t;
+	if (glide)
+	{
+		ramp_advance(&osc->inc, frames, dt);
+	}
+}
+
+static inline void triangle(osc_blep_t *osc, float *out, size_t frames, float gain, bool mix, bool glide)
+{
+	float t = osc->phase;
+	float dt = osc->inc.value;
+	float rdt = 1.0f / dt;
+	const ramp_t ramp = osc->inc;
+	float corner = 8.0f * dt;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		if (glide)
+		{
+			dt = ramp_step(&ramp, dt);
+			rdt = 1.0f / dt;
+			corner = 8.0f * dt;
+		}
+
+		/* Minimum at t = 0, maximum at t = 0.5 */
+		float y = t < 0.5f ? 4.0f * t - 1.0f : 3.0f - 4.0f * t;
+
+		y += corner * (blamp(t, dt, rdt) - blamp(wrap(t + 0.5f), dt, rdt));
+
+		out[i] = mix ? out[i] + gain * y : y;
+		t = wrap(t + dt);
+	}
+	osc->phase = t;
+	if (glide)
+	{
+		ramp_advance(&osc->inc, frames, dt);
+	}
+}
+
+/**
+ * @brief The samples still gliding with the increment stepped each one, then the
+ * rest with it constant.
+ */
+static inline void run(osc_blep_t *osc, osc_shape_t shape, float *out, size_t frames, float gain, bool mix)
+{
+	size_t n = ramp_span(&osc->inc, frames);
+
+	switch (shape)
+	{
+	case OSC_SAW:
+		if (n)
+		{
+			saw(osc, out, n, gain, mix, true);
+		}
+		saw(osc, out + n, frames - n, gain, mix, false);
+		break;
+	case OSC_PULSE:
+		if (n)
+		{
+			pulse(osc, out, n, gain, mix, true);
+		}
+		pulse(osc, out + n, frames - n, gain, mix, false);
+		break;
+	case OSC_TRIANGLE:
+		if (n)
+		{
+			triangle(osc, out, n, gain, mix, true);
+		}
+		triangle(osc, out + n, frames - n, gain, mix, false);
+		break;
+	}
+}
+
+/**
+ * @brief Sets up a voice, starting at phase 0.
+ *
+ * @param osc The voice
+ * @param shape OSC_SAW, OSC_PULSE or OSC_TRIANGLE
+ * @param frequency In Hz, below fsr / 2
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void osc_blep_init(osc_blep_t *osc, osc_shape_t shape, float frequency, float fsr)
+{
+	osc->shape = shape;
+	osc->phase = 0.0f;
+	osc->width = 0.5f;
+	ramp_init(&osc->inc, RAMP_ONE_POLE, frequency / fsr, 0.0f, fsr);
+}
+
+/**
+ * @brief Changes the frequency, straight away or gliding (see osc_blep_set_glide()).
+ *
+ * @param osc The voice
+ * @param frequency In Hz, below fsr / 2
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void osc_blep_set_frequency(osc_blep_t *osc, float frequency, float fsr)
+{
+	ramp_set_target(&osc->inc, frequency / fsr);
+}
+
+/**
+ * @brief Sets how osc_blep_set_frequency() moves to a new frequency, there is no
+ * glide after osc_blep_init().
+ *
+ * @param osc The voice
+ * @param type RAMP_LINEAR or RAMP_ONE_POLE (portamento)
+ * @param seconds Glide time, the time constant for RAMP_ONE_POLE, 0 for none
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void osc_blep_set_glide(osc_blep_t *osc, ramp_type_t type, float seconds, float fsr)
+{
+	osc->inc.type = type;
+	ramp_set_time(&osc->inc, seconds, fsr);
+}
+
+/**
+ * @brief Sets the pulse width, for PWM call this once per block.
+ * @details Clamped so each part of the cycle is at least one sample long, otherwise
+ * the two residuals overlap.
+ *
+ * @param osc The voice
+ * @param width 0 to 1, 0.5 is a square
+ */
+void osc_blep_set_width(osc_blep_t *osc, float width)
+{
+	float min = osc->inc.value;
+
+	osc->width = width < min ? min : width > 1.0f - min ? 1.0f - min : width;
+}
+
+/**
+ * @brief Renders a block, overwriting out.
+ *
+ * @param osc The voice
+ * @param out Receives the samples, -1.0 to 1.0
+ * @param frames Number of samples
+ */
+void osc_blep_render(osc_blep_t *osc, float *out, size_t frames)
+{
+	switch (osc->shape)
+	{
+	case OSC_SAW:
+		run(osc, OSC_SAW, out, frames, 1.0f, false);
+		break;
+	case OSC_PULSE:
+		run(osc, OSC_PULSE, out, frames, 1.0f, false);
+		break;
+	case OSC_TRIANGLE:
+		run(osc, OSC_TRIANGLE, out, frames, 1.0f, false);
+		break;
+	}
+}
+
+/**
+ * @brief Renders a block and adds it to out, to sum a bank of voices.
+ *
+ * @param osc The voice
+ * @param out Samples to add to
+ * @param frames Number of samples
+ * @param gain Level of this voice
+ */
+void osc_blep_mix(osc_blep_t *osc, float *out, size_t frames, float gain)
+{
+	switch (osc->shape)
+	{
+	case OSC_SAW:
+		run(osc, OSC_SAW, out, frames, gain, true);
+		break;
+	case OSC_PULSE:
+		run(osc, OSC_PULSE, out, frames, gain, true);
+		break;
+	case OSC_TRIANGLE:
+		run(osc, OSC_TRIANGLE, out, frames, gain, true);
+		break;
+	}
+}
@@ -0,0 +1,148 @@
+/**
+ * @file phasor.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Fixed-point phase-accumulator oscillators with Q31 and Q15 outputs
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * One loop per shape, the Q15 output is the top half of the Q31 one.  The shape
+ * and output width are constants at each call of run(), so each loop is just the
+ * phase add, the shape's bit twiddling and a store.
+ */
+#include <stdbool.h>
+#include "phasor.h"
+
+static inline int32_t shape_q31(phasor_shape_t shape, uint32_t phase)
+{
+	switch (shape)
+	{
+	case PHASOR_SAW:
+		return phasor_q31_saw(phase);
+	case PHASOR_SQUARE:
+		return phasor_q31_square(phase);
+	case PHASOR_TRIANGLE:
+		return phasor_q31_triangle(phase);
+	default:
+		return phasor_q31_sine(phase);
+	}
+}
+
+static inline void run(phasor_t *p, phasor_shape_t shape, void *out, size_t frames, bool q15)
+{
+	uint32_t phase = p->phase;
+	uint32_t inc = p->inc;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		int32_t y = shape_q31(shape, phase);
+
+		if (q15)
+		{
+			((int16_t *)out)[i] = (int16_t)(y >> 16);
+		}
+		else
+		{
+			((int32_t *)out)[i] = y;
+		}
+		phase += inc;
+	}
+	p->phase = phase;
+}
+
+static inline void render(phasor_t *p, void *out, size_t frames, bool q15)
+{
+	switch (p->shape)
+	{
+	case PHASOR_SAW:
+		run(p, PHASOR_SAW, out, frames, q15);
+		break;
+	case PHASOR_SQUARE:
+		run(p, PHASOR_SQUARE, out, frames, q15);
+		break;
+	case PHASOR_TRIANGLE:
+		run(p, PHASOR_TRIANGLE, out, frames, q15);
+		break;
+	case PHASOR_SINE:
+		run(p, PHASOR_SINE, out, frames, q15);
+		break;
+	}
+}
+
+/**
+ * @brief The phase increment for a frequency, work this out once not per sample.
+ * @details Single precision throughout, the M4's FPU has no double.  The ratio is
+ * held to 0 to 1 so the conversion can't overflow.
+ *
+ * @param frequency In Hz, below fsr / 2 for an oscillator, held to 0 to fsr
+ * @param fsr The sample rate (pConfig->fsr)
+ * @return uint32_t frequency / fsr * 2^32
+ */
+uint32_t phasor_increment(float frequency, float fsr)
+{
+	float ratio = frequency / fsr;
+
+	if (ratio <= 0.0f)
+	{
+		return 0;
+	}
+	if (ratio >= 1.0f)
+	{
+		return 0xFFFFFFFFU;
+	}
+	return (uint32_t)(ratio * 4294967296.0f);
+}
+
+/**
+ * @brief Sets up an oscillator, starting at phase 0.
+ *
+ * @param p The oscillator
+ * @param shape PHASOR_SAW, PHASOR_SQUARE, PHASOR_TRIANGLE or PHASOR_SINE
+ * @param frequency In Hz, below fsr / 2
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void phasor_init(phasor_t *p, phasor_shape_t shape, float frequency, float fsr)
+{
+	p->shape = shape;
+	p->phase = 0;
+	p->inc = phasor_increment(frequency, fsr);
+}
+
+/**
+ * @brief Changes the frequency, the phase carries on.
+ *
+ * @param p The oscillator
+ * @param frequency In Hz, below fsr / 2
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void phasor_set_frequency(phasor_t *p, float frequency, float fsr)
+{
+	p->inc = phasor_increment(frequency, fsr);
+}
+
+/**
+ * @brief Renders a block of Q31 samples.
+ *
+ * @param p The oscillator
+ * @param out Receives the samples
+ * @param frames Number of samples
+ */
+void phasor_render_q31(phasor_t *p, int32_t *out, size_t frames)
+{
+	render(p, out, frames, false);
+}
+
+/**
+ * @brief Renders a block of Q15 samples.
+ *
+ * @param p The oscillator
+ * @param out Receives the samples
+ * @param frames Number of samples
+ */
+void phasor_render_q15(phasor_t *p, int16_t *out, size_t frames)
+{
+	render(p, out, frames, true);
+}
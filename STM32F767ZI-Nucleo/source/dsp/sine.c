@@ -0,0 +1,159 @@
+/**
+ * @file sine.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Sine oscillators with a choice of precision against cost
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The table and polynomial backends run from a phase accumulator like the other
+ * oscillators.  The rotator has no phase, it multiplies (re, im) by the step
+ * (cos, sin of 2 pi inc) every sample.  Rounding makes the amplitude drift slowly, so
+ * once a block it is scaled by 1.5 - 0.5 * (re^2 + im^2), one Newton step towards 1.
+ * Frequency changes only recompute the step, so there is no phase jump.
+ */
+#include <math.h>
+#include <stdbool.h>
+#include "sine.h"
+
+static inline float wrap(float t)
+{
+	return t >= 1.0f ? t - 1.0f : t;
+}
+
+static inline void table(sine_osc_t *osc, const float *tab, float size, float *out, size_t frames, float gain, bool mix)
+{
+	float t = osc->phase;
+	float dt = osc->inc;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float pos = t * size;
+		int index = (int)pos;
+		float frac = pos - index;
+		float y = tab[index] + frac * (tab[index + 1] - tab[index]);
+
+		out[i] = mix ? out[i] + gain * y : y;
+		t = wrap(t + dt);
+	}
+	osc->phase = t;
+}
+
+static inline void poly(sine_osc_t *osc, float *out, size_t frames, float gain, bool mix)
+{
+	float t = osc->phase;
+	float dt = osc->inc;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float y = sine_poly(t);
+
+		out[i] = mix ? out[i] + gain * y : y;
+		t = wrap(t + dt);
+	}
+	osc->phase = t;
+}
+
+static inline void rotator(sine_osc_t *osc, float *out, size_t frames, float gain, bool mix)
+{
+	float re = osc->re;
+	float im = osc->im;
+	float c = osc->step_re;
+	float s = osc->step_im;
+
+	for (size_t i = 0; i < frames; i++)
+	{
+		float y = im;
+
+		out[i] = mix ? out[i] + gain * y : y;
+
+		float next = re * c - im * s;
+		im = re * s + im * c;
+		re = next;
+	}
+
+	/* Hold the amplitude at 1 */
+	float g = 1.5f - 0.5f * (re * re + im * im);
+	osc->re = re * g;
+	osc->im = im * g;
+}
+
+static inline void render(sine_osc_t *osc, float *out, size_t frames, float gain, bool mix)
+{
+	switch (osc->backend)
+	{
+	case SINE_TABLE_256:
+		table(osc, sine_table_256, 256.0f, out, frames, gain, mix);
+		break;
+	case SINE_TABLE_1024:
+		table(osc, sine_table_1024, 1024.0f, out, frames, gain, mix);
+		break;
+	case SINE_POLY:
+		poly(osc, out, frames, gain, mix);
+		break;
+	case SINE_ROTATOR:
+		rotator(osc, out, frames, gain, mix);
+		break;
+	}
+}
+
+/**
+ * @brief Sets up a voice, starting at phase 0.
+ *
+ * @param osc The voice
+ * @param backend Which sine, see sine.h
+ * @param frequency In Hz, below fsr / 2
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void sine_init(sine_osc_t *osc, sine_backend_t backend, float frequency, float fsr)
+{
+	osc->backend = backend;
+	osc->phase = 0.0f;
+	osc->re = 1.0f;
+	osc->im = 0.0f;
+	sine_set_frequency(osc, frequency, fsr);
+}
+
+/**
+ * @brief Changes the frequency, taking effect from the next block.
+ * @details Calls cosf() and sinf() for the rotator, so keep this to block rate.
+ *
+ * @param osc The voice
+ * @param frequency In Hz, below fsr / 2
+ * @param fsr The sample rate (pConfig->fsr)
+ */
+void sine_set_frequency(sine_osc_t *osc, float frequency, float fsr)
+{
+	osc->inc = frequency / fsr;
+
+	osc->step_re = cosf(6.28318531f * osc->inc);
+	osc->step_im = sinf(6.28318531f * osc->inc);
+}
+
+/**
+ * @brief Renders a block, overwriting out.
+ *
+ * @param osc The voice
+ * @param out Receives the samples, -1.0 to 1.0
+ * @param frames Number of samples
+ */
+void sine_render(sine_osc_t *osc, float *out, size_t frames)
+{
+	render(osc, out, frames, 1.0f, false);
+}
+
+/**
+ * @brief Renders a block and adds it to out, to sum a bank of voices.
+ *
+ * @param osc The voice
+ * @param out Samples to add to
+ * @param frames Number of samples
+ * @param gain Level of this voice
+ */
+void sine_mix(sine_osc_t *osc, float *out, size_t frames, float gain)
+{
+	render(osc, out, frames, gain, true);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file sine.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Sine oscillators with a choice of precision against cost
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Four backends:
+ *
+ *   SINE_TABLE_256  256 entry table with linear interpolation, 1K of flash.
+ *   SINE_TABLE_1024 1024 entry table, 4K, 16 times (24 dB) more accurate.
+ *   SINE_POLY       Degree 7 minimax polynomial over a quarter cycle, no table.
+ *   SINE_ROTATOR    Complex rotation by a fixed angle each sample, sin and cos
+ *                   together (im and re).  Amplitude is pulled back to 1 once a block.
+ *
+ * host/sine_thd.c measures the THD and SNR of each and host/osc_bench.c the time per
+ * sample, see the README for the figures.  The tables are generated at build time by
+ * tools/sine_gen.c.
+ *
+ * sine_poly() can also be used on its own, for LFOs or block-rate modulation.
+ */
+#ifndef DSP_SINE_H_
+#define DSP_SINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Generated, see tools/sine_gen.c.  One guard sample at the end */
+extern const float sine_table_256[256 + 1];
+extern const float sine_table_1024[1024 + 1];
+extern const int16_t sine_table_q15[1024 + 1]; /* For fixed-point oscillators */
+
+typedef enum
+{
+	SINE_TABLE_256,
+	SINE_TABLE_1024,
+	SINE_POLY,
+	SINE_ROTATOR
+} sine_backend_t;
+
+typedef struct
+{
+	sine_backend_t backend;
+	float phase; /* 0 to 1 */
+	float inc;	 /* Cycles per sample, frequency / fsr */
+	float re;		 /* Rotator state, cos and sin of the phase */
+	float im;
+	float step_re; /* Rotator step, cos and sin of 2 pi inc */
+	float step_im;
+} sine_osc_t;
+
+/**
+ * @brief sin(2 pi phase), degree 7 minimax over a quarter cycle, max error 6e-7.
+ *
+ * @param phase 0 to 1
+ * @return float -1.0 to 1.0
+ */
+static inline float sine_poly(float phase)
+{
+	/* Fold to sin(2 pi x) with x from -0.25 to 0.25 */
+	float w = phase - 0.25f;
+	w = w >= 0.5f ? w - 1.0f : w;
+	float x = 0.25f - (w < 0.0f ? -w : w);
+	float x2 = x * x;
+
+	return x * (6.283164044f + x2 * (-41.33714237f + x2 * (81.34076889f + x2 * -70.99343328f)));
+}
+
+void sine_init(sine_osc_t *osc, sine_backend_t backend, float frequency, float fsr);
+void sine_set_frequency(sine_osc_t *osc, float frequency, float fsr);
+
+void sine_render(sine_osc_t *osc, float *out, size_t frames);
+void sine_mix(sine_osc_t *osc, float *out, size_t frames, float gain);
+
+#endif /* DSP_SINE_H_ */
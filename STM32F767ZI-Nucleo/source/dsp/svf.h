@@ -0,0 +1,71 @@
+/**
+ * @file svf.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Zero-delay-feedback state variable filter with an audio rate cutoff
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * A 12 dB/oct two-pole state variable filter, built from trapezoidal integrators with
+ * the feedback loop solved exactly each sample (Zavalishin's TPT, in Simper's form).
+ * Unlike a biquad it stays well behaved however fast the cutoff moves, so it can be
+ * swept by an envelope or an oscillator at audio rate.  The responses, against the
+ * analogue prototype with s normalised to the cutoff, are
+ *
+ *   SVF_LOWPASS   1 / (s^2 + s / Q + 1)
+ *   SVF_BANDPASS  (s / Q) / (...), 0 dB at the centre
+ *   SVF_HIGHPASS  s^2 / (...)
+ *   SVF_NOTCH     (s^2 + 1) / (...)
+ *   SVF_PEAK      (1 - s^2) / (...), low pass less high pass
+ *   SVF_ALLPASS   (s^2 - s / Q + 1) / (...)
+ *
+ * svf_process() filters a block at the cutoff set by svf_set_cutoff(), the
+ * coefficients worked out once there.  svf_process_mod() takes a cutoff in Hz for
+ * every sample instead (see ramp_render() for one from a ramp), with the prewarp
+ * from zdf.h, at the cost of a divide and about 15 multiplies per sample more.
+ */
+#ifndef DSP_SVF_H_
+#define DSP_SVF_H_
+
+#include <stddef.h>
+
+typedef enum
+{
+	SVF_LOWPASS,
+	SVF_BANDPASS,
+	SVF_HIGHPASS,
+	SVF_NOTCH,
+	SVF_PEAK,
+	SVF_ALLPASS
+} svf_mode_t;
+
+typedef struct
+{
+	svf_mode_t mode;
+	float cutoff; /* Hz */
+	float q;
+	float k; /* 1 / q */
+	float scale; /* pi / fsr, for the prewarp */
+	float a1; /* Feedback solution for the cutoff */
+	float a2;
+	float a3;
+	float m0; /* Output mix of input, band and low */
+	float m1;
+	float m2;
+	float ic1; /* Integrator states */
+	float ic2;
+} svf_t;
+
+void svf_init(svf_t *svf, svf_mode_t mode, float cutoff, float q, float fsr);
+void svf_set_mode(svf_t *svf, svf_mode_t mode);
+void svf_set_cutoff(svf_t *svf, float cutoff);
+void svf_set_q(svf_t *svf, float q);
+void svf_reset(svf_t *svf);
+
+void svf_process(svf_t *svf, float *buffer, size_t frames);
+void svf_process_mod(svf_t *svf, float *buffer, const float *cutoff, size_t frames);
+
+#endif /* DSP_SVF_H_ */
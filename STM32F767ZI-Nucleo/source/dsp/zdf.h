@@ -0,0 +1,54 @@
+/**
+ * @file zdf.h
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief The cutoff prewarp shared by the zero-delay-feedback filters
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * The TPT (topology-preserving transform) filters in svf.h and ladder.h take their
+ * cutoff as g = tan(pi fc / fsr), which puts the digital cutoff exactly where the
+ * analogue one would be.  tanf() is far too slow to call per sample for an audio
+ * rate cutoff, so it is replaced by the [5/4] Pade approximant
+ *
+ *   tan(x) ~ x (945 - 105 x^2 + x^4) / (945 - 420 x^2 + 15 x^4)
+ *
+ * whose relative error is below float rounding (1e-7) up to fc = fsr / 4, 4e-6 at
+ * 0.4 fsr and 3e-4 at ZDF_CUTOFF_MAX (0.49 fsr), 0.5 cent at worst.  There is no
+ * branch and no range reduction, the denominator's root is just past pi / 2.
+ *
+ * The numerator and denominator are returned separately so a filter can fold the
+ * divide into the one it needs anyway to solve its feedback, one divide per sample.
+ */
+#ifndef DSP_ZDF_H_
+#define DSP_ZDF_H_
+
+#define ZDF_PI 3.14159265f
+#define ZDF_CUTOFF_MAX 0.49f /* Of fsr, cutoffs are held below this */
+
+/**
+ * @brief tan(x) as num / den, for 0 <= x <= ZDF_CUTOFF_MAX * pi.
+ * @details Both are scaled by 1 / 945, so den is close to 1 at low cutoffs.
+ */
+static inline void zdf_tan(float x, float *num, float *den)
+{
+	float x2 = x * x;
+
+	*num = x * (1.0f + x2 * (-1.0f / 9.0f + x2 * (1.0f / 945.0f)));
+	*den = 1.0f + x2 * (-4.0f / 9.0f + x2 * (1.0f / 63.0f));
+}
+
+/**
+ * @brief The prewarp argument pi fc / fsr, held at ZDF_CUTOFF_MAX.
+ */
+static inline float zdf_warp(float cutoff, float scale)
+{
+	float x = cutoff * scale;
+
+	return x < ZDF_CUTOFF_MAX * ZDF_PI ? x : ZDF_CUTOFF_MAX * ZDF_PI;
+}
+
+#endif /* DSP_ZDF_H_ */
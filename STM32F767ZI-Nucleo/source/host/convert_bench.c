@@ -0,0 +1,125 @@
+/**
+ * @file convert_bench.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host benchmark of the float to I2S conversion kernels (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Checks each kernel in bsp/audio_convert.c against its _ref version, bit for bit,
+ * over a block that includes the full scale and out of range samples, then times both.
+ * The host runs the portable unrolled C, the VCVT/SSAT code is only built for the
+ * target, where the pack section of the profiler (see main.c) gives its cost.
+ *
+ * Exits non-zero if any kernel differs from its reference.
+ *
+ *   STM32F767ZI-Nucleo-host-convert-bench [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio.h"
+#include "audio_convert.h"
+#include "host_clock.h"
+
+#define FRAMES SAMPLE_BLOCK_MAX
+
+static float left[FRAMES];
+static float right[FRAMES];
+static int16_t fast[FRAMES * 4] __attribute__((aligned(4)));
+static int16_t ref[FRAMES * 4] __attribute__((aligned(4)));
+
+typedef void (*mono_t)(const float *in, int16_t *out, size_t frames);
+typedef void (*stereo_t)(const float *left, const float *right, int16_t *out, size_t frames);
+
+typedef struct
+{
+	const char *name;
+	mono_t mono;
+	mono_t mono_ref;
+	stereo_t stereo;
+	stereo_t stereo_ref;
+	size_t halfwords; /* Output per frame */
+} kernel_t;
+
+static const kernel_t kernels[] = {
+		{"mono_16", audio_convert_mono_16, audio_convert_mono_16_ref, NULL, NULL, 2},
+		{"mono_32", audio_convert_mono_32, audio_convert_mono_32_ref, NULL, NULL, 4},
+		{"stereo_16", NULL, NULL, audio_convert_stereo_16, audio_convert_stereo_16_ref, 2},
+		{"stereo_32", NULL, NULL, audio_convert_stereo_32, audio_convert_stereo_32_ref, 4},
+};
+
+/**
+ * @brief Fills the inputs with noise, plus the edge cases at the start.
+ */
+static void fill(void)
+{
+	static const float edges[] = {1.0f, -1.0f, 1.5f, -1.5f, 0.99999994f, -0.99999994f, 0.0f, -0.0f,
+																0.5f, -0.5f, 3.0517578e-05f, -3.0517578e-05f, 1e-10f, 100.0f, -100.0f, 0.25f};
+	size_t n = sizeof(edges) / sizeof(edges[0]);
+
+	srand(1);
+	for (size_t i = 0; i < FRAMES; i++)
+	{
+		left[i] = i < n ? edges[i] : 2.2f * rand() / RAND_MAX - 1.1f;
+		right[i] = i < n ? edges[n - 1 - i] : 2.2f * rand() / RAND_MAX - 1.1f;
+	}
+}
+
+static void run(const kernel_t *k, bool reference, int16_t *out)
+{
+	if (k->mono != NULL)
+	{
+		(reference ? k->mono_ref : k->mono)(left, out, FRAMES);
+	}
+	else
+	{
+		(reference ? k->stereo_ref : k->stereo)(left, right, out, FRAMES);
+	}
+}
+
+static double time_ns(const kernel_t *k, bool reference, int16_t *out, long iterations)
+{
+	double start = host_now_ns();
+
+	for (long i = 0; i < iterations; i++)
+	{
+		run(k, reference, out);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+int main(int argc, char *argv[])
+{
+	long iterations = argc > 1 ? atol(argv[1]) : 20000;
+	int failed = 0;
+
+	fill();
+
+	printf("%-10s %12s %12s %8s  %s\n", "kernel", "ref ns/frame", "ns/frame", "speedup", "matches ref");
+
+	for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++)
+	{
+		const kernel_t *k = &kernels[i];
+		size_t bytes = FRAMES * k->halfwords * sizeof(int16_t);
+
+		memset(fast, 0x55, sizeof(fast));
+		memset(ref, 0xAA, sizeof(ref));
+		run(k, false, fast);
+		run(k, true, ref);
+
+		bool match = memcmp(fast, ref, bytes) == 0;
+		failed |= !match;
+
+		double t_ref = time_ns(k, true, ref, iterations);
+		double t_fast = time_ns(k, false, fast, iterations);
+
+		printf("%-10s %12.3f %12.3f %7.2fx  %s\n", k->name, t_ref, t_fast, t_ref / t_fast, match ? "yes" : "NO");
+	}
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file fx_bench.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host benchmark of the effects (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Times a block of SAMPLE_BLOCK_SIZE samples through a delay line (dsp/delay.c) of
+ * DELAY_SIZE(16), float and Q15, read at a whole number of samples, then linear,
+ * Lagrange and allpass interpolated at a delay swept by a sine the way a chorus
+ * would, and moved a block at a time with delay_write_block() and
+ * delay_read_block().  Prints the time per sample for each.  Then the reverbs, the
+ * FDN (dsp/fdn.c) in both profiles and the fixed-point plate (dsp/plate.c), the
+ * time per stereo frame.
+ * These are host figures, for the target put the effect in a profiler section (see
+ * main.c) and divide its mean cycles by the block size.
+ *
+ *   STM32F767ZI-Nucleo-host-fx-bench [iterations]
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio.h"
+#include "delay.h"
+#include "fdn.h"
+#include "host_clock.h"
+#include "plate.h"
+
+#define FRAMES SAMPLE_BLOCK_SIZE
+#define FSR 48000.0f
+#define BITS 16
+
+typedef enum
+{
+	READ_TAP,
+	READ_LINEAR,
+	READ_LAGRANGE,
+	READ_ALLPASS,
+	READ_BLOCK,
+} read_t;
+
+static float buffer[DELAY_SIZE(BITS)];
+static int16_t buffer_q15[DELAY_SIZE(BITS)];
+static float reverb_ram[FDN_LUSH_RAM / sizeof(float)];
+static float in[FRAMES];
+static float out[FRAMES];
+static float left[FRAMES];
+static float right[FRAMES];
+static float times[FRAMES];
+
+static double time_float_ns(read_t read, long iterations)
+{
+	delay_t d;
+	float state = 0.0f;
+	double start;
+
+	delay_init(&d, buffer, DELAY_SIZE(BITS));
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (read == READ_BLOCK)
+		{
+			delay_read_block(&d, out, 1000, FRAMES);
+			delay_write_block(&d, in, FRAMES);
+		}
+		else
+		{
+			for (int n = 0; n < FRAMES; n++)
+			{
+				switch (read)
+				{
+				case READ_TAP:
+					out[n] = delay_tap(&d, 1000);
+					break;
+				case READ_LINEAR:
+					out[n] = delay_read_linear(&d, times[n]);
+					break;
+				case READ_LAGRANGE:
+					out[n] = delay_read_lagrange(&d, times[n]);
+					break;
+				default:
+					out[n] = delay_read_allpass(&d, times[n], &state);
+					break;
+				}
+				delay_write(&d, in[n]);
+			}
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_q15_ns(read_t read, long iterations)
+{
+	delay_q15_t d;
+	float state = 0.0f;
+	double start;
+
+	delay_q15_init(&d, buffer_q15, DELAY_SIZE(BITS));
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		if (read == READ_BLOCK)
+		{
+			delay_q15_read_block(&d, out, 1000, FRAMES);
+			delay_q15_write_block(&d, in, FRAMES);
+		}
+		else
+		{
+			for (int n = 0; n < FRAMES; n++)
+			{
+				switch (read)
+				{
+				case READ_TAP:
+					out[n] = delay_q15_tap(&d, 1000);
+					break;
+				case READ_LINEAR:
+					out[n] = delay_q15_read_linear(&d, times[n]);
+					break;
+				case READ_LAGRANGE:
+					out[n] = delay_q15_read_lagrange(&d, times[n]);
+					break;
+				default:
+					out[n] = delay_q15_read_allpass(&d, times[n], &state);
+					break;
+				}
+				delay_q15_write(&d, in[n]);
+			}
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_fdn_ns(fdn_profile_t profile, long iterations)
+{
+	static fdn_t reverb;
+	double start;
+
+	fdn_init(&reverb, profile, reverb_ram, profile == FDN_COMPACT ? FDN_COMPACT_RAM : FDN_LUSH_RAM, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		/* Fresh input each block, the output adds to it */
+		memcpy(left, in, sizeof(left));
+		memcpy(right, in, sizeof(right));
+		fdn_process(&reverb, left, right, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+static double time_plate_ns(long iterations)
+{
+	static plate_t reverb;
+	double start;
+
+	plate_init(&reverb, reverb_ram, PLATE_RAM, FSR);
+
+	start = host_now_ns();
+	for (long i = 0; i < iterations; i++)
+	{
+		memcpy(left, in, sizeof(left));
+		memcpy(right, in, sizeof(right));
+		plate_process(&reverb, left, right, FRAMES);
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+int main(int argc, char *argv[])
+{
+	static const struct
+	{
+		const char *name;
+		read_t read;
+	} reads[] = {
+			{"tap", READ_TAP},
+			{"linear", READ_LINEAR},
+			{"lagrange", READ_LAGRANGE},
+			{"allpass", READ_ALLPASS},
+			{"block", READ_BLOCK},
+	};
+	long iterations = argc > 1 ? atol(argv[1]) : 50000;
+
+	for (int i = 0; i < FRAMES; i++)
+	{
+		in[i] = (float)rand() / RAND_MAX - 0.5f;
+		times[i] = 960.0f + 240.0f * sinf(2.0f * (float)M_PI * i / FRAMES);
+	}
+
+	printf("%u samples per block, delay line of %lu\n", FRAMES, DELAY_SIZE(BITS));
+	printf("%-18s %13s %13s\n", "delay read", "float", "q15");
+	printf("%-18s %13s %13s\n", "and write", "ns/sample", "ns/sample");
+
+	for (size_t r = 0; r < sizeof(reads) / sizeof(reads[0]); r++)
+	{
+		printf("%-18s %13.3f %13.3f\n", reads[r].name, time_float_ns(reads[r].read, iterations),
+					 time_q15_ns(reads[r].read, iterations));
+	}
+
+	printf("\n%-18s %13s %13s\n", "reverb", "ns/frame", "RAM");
+	printf("%-18s %13.3f %12luK\n", "fdn compact", time_fdn_ns(FDN_COMPACT, iterations / 4), FDN_COMPACT_RAM / 1024);
+	printf("%-18s %13.3f %12luK\n", "fdn lush", time_fdn_ns(FDN_LUSH, iterations / 4), FDN_LUSH_RAM / 1024);
+	printf("%-18s %13.3f %12luK\n", "plate q31", time_plate_ns(iterations / 4), PLATE_RAM / 1024);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file profile_host.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host time base and report for the render budget profiler (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <stdio.h>
+#include "host_clock.h"
+#include "profile.h"
+
+/**
+ * @brief Stands in for DWT->CYCCNT, a free running (wrapping) nanosecond count.
+ *
+ * @return uint32_t Nanoseconds
+ */
+uint32_t profile_now(void)
+{
+	return (uint32_t)host_now_ns();
+}
+
+/**
+ * @brief Prints every section that has run.
+ */
+void profile_print(void)
+{
+	profile_stats_t stats;
+
+	for (uint8_t i = 0; i < PROFILE_SECTIONS; i++)
+	{
+		if (!profile_get(i, &stats))
+		{
+			continue;
+		}
+
+		printf("%-10s %8u calls, min %8.2f us, mean %8.2f us, max %8.2f us, usage mean %5.1f%% max %5.1f%%\n",
+					 stats.name ? stats.name : "?", stats.count,
+					 stats.min / 1e3, stats.mean / 1e3, stats.max / 1e3,
+					 stats.usage_mean, stats.usage_max);
+	}
+}
@@ -0,0 +1,146 @@
+/**
+ * @file render_bench.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Host benchmark of staged, fixed-point and direct rendering (host builds only)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Times a refill of one segment both ways, with the same saw as main.c:
+ *
+ *   staged  float saw into the L/R blocks, then config->pack into the segment
+ *   fixed   phasor saw (see phasor.h) into a Q31/Q15 block, then the mono _q31/_q15
+ *           packer into the segment
+ *   direct  phasor saw written into the segment with audio_frame_16/32()
+ *
+ * for 16 and 24/32-bit frames.  The staged figure includes the float block being
+ * written and read back, which is what RENDER_DIRECT saves.  On the target the
+ * refill section of the profiler (see main.c) gives the same comparison.
+ *
+ *   STM32F767ZI-Nucleo-host-render-bench [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "audio.h"
+#include "audio_convert.h"
+#include "host_clock.h"
+#include "phasor.h"
+
+#define FRAMES SAMPLE_BLOCK_SIZE
+#define TEST_TONE 440.0f
+#define FSR 48000.0f
+
+static float left[FRAMES];
+static float right[FRAMES];
+static int32_t block_q31[FRAMES];
+static int16_t block_q15[FRAMES];
+static int16_t segment[FRAMES * 4] __attribute__((aligned(4)));
+
+static float acc;
+static phasor_t saw;
+
+static void staged(audio_pack_t pack)
+{
+	float inc = TEST_TONE / FSR;
+
+	for (size_t i = 0; i < FRAMES; i++)
+	{
+		if (acc > 1.0f)
+		{
+			acc -= 1.0f;
+		}
+
+		left[i] = right[i] = (2.0f * acc - 1.0f);
+		acc += inc;
+	}
+
+	pack(left, right, segment, FRAMES);
+}
+
+static void fixed(uint8_t bits)
+{
+	if (bits == 16)
+	{
+		phasor_render_q15(&saw, block_q15, FRAMES);
+		audio_convert_mono_q15(block_q15, segment, FRAMES);
+	}
+	else
+	{
+		phasor_render_q31(&saw, block_q31, FRAMES);
+		audio_convert_mono_q31(block_q31, segment, FRAMES);
+	}
+}
+
+static void direct(uint8_t bits)
+{
+	uint32_t *word = (uint32_t *)segment;
+
+	if (bits == 16)
+	{
+		for (size_t i = 0; i < FRAMES; i++)
+		{
+			int32_t sample = phasor_q31_saw(phasor_next(&saw)) >> 16;
+
+			*word++ = audio_frame_16(sample, sample);
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < FRAMES; i++)
+		{
+			uint32_t sample = audio_frame_32(phasor_q31_saw(phasor_next(&saw)));
+
+			*word++ = sample;
+			*word++ = sample;
+		}
+	}
+}
+
+static double time_ns(uint8_t bits, int path, long iterations)
+{
+	audio_pack_t pack = bits == 16 ? audio_convert_stereo_16 : audio_convert_stereo_32;
+	double start = host_now_ns();
+
+	for (long i = 0; i < iterations; i++)
+	{
+		switch (path)
+		{
+		case 0:
+			staged(pack);
+			break;
+		case 1:
+			fixed(bits);
+			break;
+		default:
+			direct(bits);
+			break;
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	return (host_now_ns() - start) / ((double)iterations * FRAMES);
+}
+
+int main(int argc, char *argv[])
+{
+	long iterations = argc > 1 ? atol(argv[1]) : 20000;
+	static const uint8_t bits[] = {16, 32};
+
+	printf("%u frames per refill\n", FRAMES);
+	phasor_init(&saw, PHASOR_SAW, TEST_TONE, FSR);
+
+	printf("%-5s %15s %15s %15s %8s\n", "bits", "staged ns/frame", "fixed ns/frame", "direct ns/frame", "speedup");
+
+	for (size_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++)
+	{
+		double t_staged = time_ns(bits[i], 0, iterations);
+		double t_fixed = time_ns(bits[i], 1, iterations);
+		double t_direct = time_ns(bits[i], 2, iterations);
+
+		printf("%-5u %15.3f %15.3f %15.3f %7.2fx\n", bits[i], t_staged, t_fixed, t_direct, t_staged / t_direct);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file wavetable_gen.c
+ * @author yizakat (yizakat@yizakat.com)
+ * @brief Build-time generator for the wavetable oscillator's tables (runs on the build machine)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @details
+ *
+ * Writes the C source for wavetable_bank[] (see dsp/wavetable.h).  Each frame is
+ * summed from its harmonics in double precision, once per mip level with only the
+ * harmonics that level allows, so every level is band-limited exactly.  A frame is
+ * scaled by the peak of its level 0 table, so switching level doesn't change the
+ * loudness.
+ *
+ * The frames, in morph order:
+ *
+ *   0 sine, 1 triangle, 2 saw, 3 square, 4 pulse 25%, 5 pulse 12.5%,
+ *   6 organ (drawbar-like harmonics), 7 formant (a band of harmonics round the 8th)
+ *
+ *   wavetable_gen <output.c>
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "wavetable.h"
+
+#define PI 3.14159265358979323846
+
+static double table[WAVETABLE_SIZE];
+
+/**
+ * @brief Band-limited saw, the Fourier series to a given harmonic.
+ */
+static double saw(double t, int harmonics)
+{
+	double y = 0.0;
+
+	for (int h = 1; h <= harmonics; h++)
+	{
+		y += sin(2.0 * PI * h * t) / h;
+	}
+	return y;
+}
+
+/**
+ * @brief One sample of a frame, t is 0 to 1 through the cycle.
+ */
+static double frame_sample(int frame, double t, int harmonics)
+{
+	static const double organ[] = {1.0, 0.8, 0.6, 0.5, 0.0, 0.4, 0.0, 0.3};
+	double y = 0.0;
+
+	switch (frame)
+	{
+	case 0:
+		return sin(2.0 * PI * t);
+	case 1:
+		for (int h = 1; h <= harmonics; h += 2)
+		{
+			y += ((h / 2) % 2 ? -1.0 : 1.0) * sin(2.0 * PI * h * t) / (h * h);
+		}
+		return y;
+	case 2:
+		return saw(t, harmonics);
+	case 3:
+		return saw(t, harmonics) - saw(t + 0.5, harmonics);
+	case 4:
+		return saw(t, harmonics) - saw(t + 0.25, harmonics);
+	case 5:
+		return saw(t, harmonics) - saw(t + 0.125, harmonics);
+	case 6:
+		for (int h = 1; h <= harmonics && h <= 8; h++)
+		{
+			y += organ[h - 1] * sin(2.0 * PI * h * t);
+		}
+		return y;
+	default:
+		for (int h = 1; h <= harmonics; h++)
+		{
+			double formant = (h - 8.0) / 3.0;
+
+			y += (exp(-formant * formant) + 0.3 * exp(-(h - 1.0) * (h - 1.0))) * sin(2.0 * PI * h * t);
+		}
+		return y;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *out;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s <output.c>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	out = fopen(argv[1], "w");
+	if (out == NULL)
+	{
+		fprintf(stderr, "Unable to create %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(out, "/* Generated by tools/wavetable_gen.c, do not edit */\n");
+	fprintf(out, "#include \"wavetable.h\"\n\n");
+	fprintf(out, "const float wavetable_bank[WAVETABLE_FRAMES][WAVETABLE_LEVELS][WAVETABLE_STRIDE] = {\n");
+
+	for (int frame = 0; frame < WAVETABLE_FRAMES; frame++)
+	{
+		double scale = 0.0;
+
+		fprintf(out, "\t{\n");
+		for (int level = 0; level < WAVETABLE_LEVELS; level++)
+		{
+			int harmonics = (WAVETABLE_SIZE / 2) >> level;
+
+			for (int i = 0; i < WAVETABLE_SIZE; i++)
+			{
+				table[i] = frame_sample(frame, (double)i / WAVETABLE_SIZE, harmonics);
+			}
+
+			/* The level 0 peak sets the scale for every level */
+			if (level == 0)
+			{
+				for (int i = 0; i < WAVETABLE_SIZE; i++)
+				{
+					scale = fmax(scale, fabs(table[i]));
+				}
+				scale = 1.0 / scale;
+			}
+
+			/* One guard sample before, two after */
+			fprintf(out, "\t\t{");
+			for (int i = -1; i < WAVETABLE_SIZE + 2; i++)
+			{
+				fprintf(out, "%s%.8ef", i == -1 ? "" : (i + 1) % 6 ? ", " : ",\n\t\t ",
+								table[(i + WAVETABLE_SIZE) % WAVETABLE_SIZE] * scale);
+			}
+			fprintf(out, "},\n");
+		}
+		fprintf(out, "\t},\n");
+	}
+	fprintf(out, "};\n");
+
+	return fclose(out) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}